@@ -3,8 +3,14 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
+#include "RunningStats.h"
 #include "TransactionData.h"
 
 struct Alert {
@@ -27,14 +33,42 @@ public:
     // Set overall spending limit
     void setOverallLimit(double limit);
     
+    // Currency symbol used in alert messages (default USD)
+    void setReportingCurrency(const std::string& currency);
+    
+    const std::map<std::string, double>& getCategoryLimits() const { return categoryLimits; }
+    double getOverallLimit() const { return overallLimit; }
+    
     // Check transactions against limits and generate alerts
     std::vector<Alert> checkTransactions(const TransactionData& data);
     
     // Check if category exceeded limit
     bool isCategoryExceeded(const std::string& category) const;
     
+    // Streaming anomaly detection, fed each newly imported transaction once its file has been
+    // parsed, converted and de-duplicated. Keeps running mean/variance per category and per
+    // merchant; a charge more than `sigmas` standard deviations above either mean (after
+    // `minSamples` charges) raises a WARNING. Returns true when an alert was emitted.
+    // Thread-safe.
+    bool observeTransaction(const Transaction& transaction);
+    void setAnomalyThreshold(double sigmas, uint64_t minSamples = 8);
+    
+    // Invoked inline for every anomaly alert, on the thread that observed the transaction
+    void setAlertCallback(std::function<void(const Alert&)> callback);
+    
+    std::vector<Alert> getIngestAlerts() const;
+    
 private:
     std::map<std::string, double> categoryLimits;
     double overallLimit;
+    std::string currencySymbol;
     std::vector<Alert> alerts;
+    
+    double anomalySigmas;
+    uint64_t anomalyMinSamples;
+    std::unordered_map<std::string, RunningStats> categoryStats;
+    std::unordered_map<std::string, RunningStats> merchantStats;
+    std::vector<Alert> ingestAlerts;
+    std::function<void(const Alert&)> alertCallback;
+    mutable std::mutex ingestMutex;
 };
@@ -20,7 +20,19 @@
 #pragma once
 
 #include "TransactionData.h"
+#include "CategoryTree.h"
+#include "DataCube.h"
+#include "Forecaster.h"
+#include "HeavyHitters.h"
+#include "Reconciler.h"
+#include "RecurringDetector.h"
+#include "TimeSeries.h"
+#include "TransferMatcher.h"
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -28,16 +40,61 @@ struct BudgetSummary {
     double totalIncome;
     double totalExpenses;
     double netChange;
+    double distinctMerchants;  // HyperLogLog estimate
+    size_t matchedTransfers;   // Cross-account pairs left out of every total below
+    double transferVolume;     // Amount moved by those pairs
     std::map<std::string, double> categoryBreakdown;
     std::map<std::string, double> accountBreakdown;
     std::map<std::string, double> monthlyTrends;
 };
 
+// Transaction-size distribution (absolute amounts) of one group, from a quantile sketch
+struct SizeDistribution {
+    uint64_t count;
+    double median;
+    double p90;
+    double p99;
+};
+
+struct SizeDistributions {
+    SizeDistribution overall;
+    std::map<std::string, SizeDistribution> byCategory;
+    std::map<std::string, SizeDistribution> byAccount;
+    std::map<std::string, SizeDistribution> byMonth;
+};
+
+// Heaviest merchants (normalized descriptions) among expenses
+struct MerchantReport {
+    std::vector<HeavyHitter> bySpend;  // weight = total spent
+    std::vector<HeavyHitter> byCount;  // weight = number of purchases
+};
+
+// Approximate number of distinct merchants per group (HyperLogLog)
+struct DistinctCounts {
+    double overall;
+    std::map<std::string, double> byMonth;
+    std::map<std::string, double> byCategory;
+    std::map<std::string, double> byAccount;
+};
+
+struct MerchantSketches;
+
+// Results are memoized against TransactionData::getVersion(), so repeated queries are free
+// until the underlying data changes. All queries are safe to call from multiple threads.
 class BudgetAnalyzer {
 public:
     BudgetAnalyzer(const TransactionData& data);
     ~BudgetAnalyzer() = default;
     
+    BudgetAnalyzer(const BudgetAnalyzer&) = delete;
+    BudgetAnalyzer& operator=(const BudgetAnalyzer&) = delete;
+    
+    // Outflows and inflows between our own accounts within this many days of each other are
+    // paired and excluded from income, expenses and every breakdown; negative disables.
+    // Not synchronized with concurrent queries.
+    void setTransferMatchWindow(int days);
+    std::vector<TransferMatch> getTransfers() const;
+    
     BudgetSummary analyzeBudget() const;
     
     std::map<std::string, double> getTopSpendingCategories(int limit = 5) const;
@@ -48,6 +105,83 @@ public:
     double getAverageMonthlySpending() const;
     double getAverageTransaction() const;
     
+    // Prefix-summed spending series; every window query on it is O(1)
+    std::shared_ptr<const SpendingTimeSeries>
+    getTimeSeries(Granularity granularity = Granularity::Month) const;
+    
+    // Rolling sum/average over the latest `months` months (e.g. 3, 6, 12)
+    double getRollingSpending(size_t months, const std::string& category = "") const;
+    double getRollingAverageSpending(size_t months, const std::string& category = "") const;
+    
+    // Percentage change of the latest month against the previous month / same month last year
+    double getMonthOverMonthChange(const std::string& category = "") const;
+    double getYearOverYearChange(const std::string& category = "") const;
+    
+    // Median/p90/p99 transaction size, sketched per group with bounded memory
+    SizeDistributions getSizeDistributions() const;
+    std::map<std::string, SizeDistribution> getCategorySizeDistribution() const;
+    std::map<std::string, SizeDistribution> getAccountSizeDistribution() const;
+    std::map<std::string, SizeDistribution> getMonthlySizeDistribution() const;
+    
+    // Top merchants from a single streaming pass with bounded memory
+    MerchantReport getTopMerchants(size_t limit = 25) const;
+    
+    // Distinct merchants per month, category and account in fixed memory per group
+    DistinctCounts getDistinctMerchants() const;
+    
+    // Weekly/monthly/annual recurring charges with their next expected date and amount
+    std::vector<RecurringSeries> getRecurringPayments() const;
+    
+    // Running balances checked against each account's reported balance column
+    std::vector<AccountReconciliation> getReconciliation() const;
+    
+    // Projected balances per account from the active recurring series
+    std::vector<CashFlowProjection> getCashFlowProjection(int days = 90) const;
+    
+    // Category x account x month aggregate every summary above is rolled up from
+    std::shared_ptr<const DataCube> getDataCube() const;
+    
+    // Totals at every level of the '/'-separated category hierarchy
+    std::shared_ptr<const CategoryTree> getCategoryTree() const;
+    
+    // Spending (<= 0) of a category path and everything below it; 0 for unknown paths
+    double getCategoryTotal(const std::string& path) const;
+    
+    // Expected spending per category and account for the next `months` months (at most 24)
+    ForecastResult getSpendingForecast(size_t months = 3) const;
+    
 private:
+    template <typename T>
+    struct CachedResult {
+        std::mutex mutex;
+        bool valid = false;
+        uint64_t version = 0;
+        uint64_t settings = 0;
+        T value;
+    };
+    
+    template <typename T, typename Compute>
+    T cached(CachedResult<T>& slot, Compute compute) const;
+    
+    // One flag per row, set for both sides of every matched transfer
+    std::vector<bool> getTransferMask() const;
+    
     const TransactionData& transactionData;
+    int transferWindow;
+    std::atomic<uint64_t> settingsVersion;  // Bumped by setters so cached results recompute
+    
+    mutable CachedResult<BudgetSummary> summaryCache;
+    mutable CachedResult<std::map<std::string, double>> categoryCache;
+    mutable CachedResult<std::map<std::string, double>> monthlyCache;
+    mutable CachedResult<double> averageTransactionCache;
+    mutable CachedResult<std::shared_ptr<const SpendingTimeSeries>> timeSeriesCache[4];
+    mutable CachedResult<std::shared_ptr<const DataCube>> cubeCache;
+    mutable CachedResult<std::vector<TransferMatch>> transferCache;
+    mutable CachedResult<std::shared_ptr<const CategoryTree>> categoryTreeCache;
+    mutable CachedResult<SizeDistributions> sizeDistributionCache;
+    mutable CachedResult<std::shared_ptr<const MerchantSketches>> merchantCache;
+    mutable CachedResult<DistinctCounts> distinctCache;
+    mutable CachedResult<std::vector<RecurringSeries>> recurringCache;
+    mutable CachedResult<ForecastResult> forecastCache;
+    mutable CachedResult<std::vector<AccountReconciliation>> reconciliationCache;
 };
@@ -0,0 +1,46 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "AlertSystem.h"
+#include "DataCube.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct LimitOutlook {
+    std::string category;          // "Overall" for the overall limit
+    double limit;                  // 0 when no limit is configured
+    double exceedanceProbability;  // Share of simulated months spending more than the limit
+    double median;                 // Simulated monthly spending percentiles (positive)
+    double p90;
+    double p95;
+    double p99;
+};
+
+struct SimulationResult {
+    size_t scenarios = 0;
+    size_t historyMonths = 0;      // Months of history actually sampled from
+    std::vector<LimitOutlook> outlooks;
+};
+
+// Monte Carlo what-if engine for the AlertSystem limits. Each scenario is one simulated
+// month: every category's spending is bootstrapped independently from its own last
+// `historyMonths` monthly totals, and the draws are summed per limit. A limit on a category
+// path also covers its subcategories ("Food" includes "Food/Dining").
+// Scenarios run in fixed-size blocks on the shared pool; each block owns an RNG stream
+// derived from the seed and block index, so results do not depend on the thread count.
+class BudgetSimulator {
+public:
+    explicit BudgetSimulator(size_t scenarios = 10000, size_t historyMonths = 12,
+                             uint64_t seed = 0x5eed);
+    
+    SimulationResult run(const DataCube& cube, const AlertSystem& alerts) const;
+    
+private:
+    size_t scenarios;
+    size_t historyMonths;
+    uint64_t seed;
+};
@@ -28,11 +28,17 @@ struct Transaction {
     std::string date;
     std::string description;
     std::string category;
-    double amount;
-    double balance;
+    double amount;            // In the reporting currency
+    double balance;           // As reported, in the statement currency
+    bool hasBalance;          // The statement reported a running balance for this row
     std::string accountName;
+    std::string currency;     // ISO code of the statement; empty means the reporting currency
+    double fxRate;            // Reporting-currency units per statement unit used for amount
+    const std::string* merchant;  // Interned merchant key (see merchantKey); null until ingested
     
-    Transaction() : amount(0.0), balance(0.0) {}
+    Transaction() : amount(0.0), balance(0.0), hasBalance(false), fxRate(1.0), merchant(nullptr) {}
+    
+    double statementAmount() const { return amount / fxRate; }
 };
 
 class CSVParser {
@@ -55,5 +61,7 @@ private:
     std::vector<std::string> splitLine(const std::string& line, char delimiter = ',');
     std::string trim(const std::string& str);
     double parseAmount(const std::string& amount);
-    std::string categorizeTransaction(const std::string& description);
+    
+    // Second pipeline stage: categorize a parsed file in one batch
+    void categorize(std::vector<Transaction>& transactions);
 };
@@ -0,0 +1,53 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+using CategoryId = uint32_t;
+
+struct CategoryCacheStats {
+    uint64_t hits;
+    uint64_t misses;
+    size_t entries;
+};
+
+// Bounded, thread-safe memo from a normalized description to its category id.
+// Keys are spread over independently locked shards so parser threads rarely contend. A shard
+// that reaches its share of the capacity is emptied rather than tracking recency: recurring
+// merchants are re-learned within a few rows, and lookups stay a single hash probe.
+class CategoryCache {
+public:
+    static constexpr size_t kShards = 16;
+    
+    explicit CategoryCache(size_t capacity = 65536);
+    
+    bool lookup(const std::string& key, CategoryId& id) const;
+    void insert(const std::string& key, CategoryId id);
+    
+    // Drops every entry and resets the counters
+    void clear();
+    
+    CategoryCacheStats stats() const;
+    size_t getCapacity() const { return shardCapacity * kShards; }
+    
+private:
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, CategoryId> entries;
+    };
+    
+    size_t shardCapacity;
+    mutable std::array<Shard, kShards> shards;
+    mutable std::atomic<uint64_t> hits;
+    mutable std::atomic<uint64_t> misses;
+    
+    Shard& shardFor(const std::string& key) const;
+};
@@ -0,0 +1,19 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct Transaction;
+
+// Second-chance categorizer for rows the rules left in "Other" (see
+// TransactionData::fillUncategorized). Implementations must be safe to call concurrently.
+class CategoryFallback {
+public:
+    virtual ~CategoryFallback() = default;
+    
+    // One category per row, or an empty string where there is no confident answer
+    virtual std::vector<std::string> suggest(const std::vector<const Transaction*>& rows) const = 0;
+};
@@ -0,0 +1,49 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "DataCube.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct CategoryNode {
+    std::string name;               // Last path segment, e.g. "Coffee"
+    std::string path;               // Full path, e.g. "Food/Dining/Coffee"
+    size_t parent;                  // CategoryTree::npos for top-level categories
+    int depth;                      // 0 for top-level categories
+    std::vector<size_t> children;   // Sorted by name
+    CubeCell direct;                // Transactions categorized exactly at this node
+    CubeCell total;                 // direct plus every descendant
+};
+
+// Hierarchy of '/'-separated category paths with totals at every level.
+// Leaf totals come from the cube's category roll-up, so no transaction is revisited; every
+// parent is created before its children, which makes a reverse walk over the node array a
+// post-order traversal that rolls totals up in one pass.
+class CategoryTree {
+public:
+    static constexpr size_t npos = SIZE_MAX;
+    static constexpr char kSeparator = '/';
+    
+    explicit CategoryTree(const DataCube& cube);
+    
+    const std::vector<CategoryNode>& getNodes() const { return nodes; }
+    const std::vector<size_t>& getRoots() const { return roots; }
+    size_t find(const std::string& path) const;
+    
+    // Parents before children, siblings by name; the order used for outlined display
+    std::vector<size_t> preOrder() const;
+    
+    // Trims segments and drops empty ones: " Food // Coffee " -> "Food/Coffee"
+    static std::string normalizePath(const std::string& category);
+    
+private:
+    std::vector<CategoryNode> nodes;
+    std::vector<size_t> roots;
+    std::unordered_map<std::string, size_t> pathIndex;
+    
+    size_t intern(const std::string& path);
+};
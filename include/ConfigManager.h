@@ -3,34 +3,150 @@
 
 #pragma once
 
+#include "CategoryCache.h"
+#include "MappedFile.h"
+#include "RuleProgram.h"
+#include <functional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <map>
 #include <memory>
+#include <mutex>
 
-struct CategoryRule {
-    std::string category;
-    std::vector<std::string> keywords;  // Any of these keywords triggers the category
+// Contents of a categories.json file
+struct CategoryConfig {
+    std::vector<CategoryRule> rules;
+    // (normalized merchant, category); checked before any rule
+    std::vector<std::pair<std::string, std::string>> overrides;
 };
 
 class ConfigManager {
 public:
+    static constexpr CategoryId kOther = 0;
+    static constexpr size_t kParallelBatch = 4096;
+    static constexpr const char* kRuleCacheSuffix = ".cache";
+    static constexpr int kReloadDebounceMs = 100;
+    
+    // `previous` holds the rules in effect before the reload attempt, so data categorized
+    // under them can be brought up to date incrementally (TransactionData::recategorize)
+    using ReloadCallback = std::function<void(bool loaded, const std::string& message,
+                                              const CategoryConfig& previous)>;
+    
     ConfigManager();
+    ~ConfigManager();
+    
+    ConfigManager(const ConfigManager&) = delete;
+    ConfigManager& operator=(const ConfigManager&) = delete;
     
-    // Load configuration from JSON file
+    // Load configuration from JSON file. The compiled rules are cached next to it in
+    // <filePath>.cache and memory-mapped on later loads while the JSON is unchanged.
     bool loadCategoriesFromFile(const std::string& filePath);
     
+    // Hot reload: watch filePath with inotify (on its directory, so editors that save by
+    // renaming a new file over it are seen too) and reload it on a background thread once
+    // changes settle. Each load is published as a new immutable rule set by an atomic
+    // pointer swap; categorization never waits on a reload, and a call already running
+    // finishes on the rule set it started with. Returns false if the file cannot be watched.
+    bool watchCategoriesFile(const std::string& filePath);
+    void stopWatching();
+    // Invoked on the watcher thread after every reload attempt
+    void setReloadCallback(ReloadCallback callback);
+    
+    // Bumped each time a rule set is published
+    uint64_t getRulesVersion() const { return snapshot()->version; }
+    
+    // True when the current rules came from the compiled cache rather than a compile
+    bool loadedFromRuleCache() const { return snapshot()->fromCache; }
+    
+    // Parses the categories.json schema; throws std::runtime_error on malformed JSON
+    static CategoryConfig parseCategories(std::string_view json);
+    
     // Get category based on transaction description
     std::string categorizeTransaction(const std::string& description) const;
     
+    // Category id for a transaction, memoized on its normalized description plus whatever
+    // context (account, amount and date ranges) the rules look at. Safe to call from several
+    // parser threads at once; id kOther means no override or rule matched.
+    CategoryId categorize(const CategorizationInput& input) const;
+    // Description only: rules with account, amount or date conditions never match
+    CategoryId categorize(std::string_view description) const;
+    
+    // Categorizes a whole parsed chunk: ids[i] = categorize(inputs[i]). Batches of at least
+    // kParallelBatch rows are split across the shared thread pool. The whole batch sees one
+    // rule set.
+    void categorizeBatch(const CategorizationInput* inputs, CategoryId* ids, size_t count) const;
+    std::vector<CategoryId> categorizeBatch(const std::vector<CategorizationInput>& inputs) const;
+    void categorizeBatch(const std::string_view* descriptions, CategoryId* ids, size_t count) const;
+    std::vector<CategoryId> categorizeBatch(const std::vector<std::string_view>& descriptions) const;
+    
+    // Ids are never reassigned: a category dropped by a reload keeps its id and name, so an id
+    // obtained from any earlier rule set still resolves
+    std::string categoryName(CategoryId id) const { return snapshot()->categoryNames[id]; }
+    size_t categoryCount() const { return snapshot()->categoryNames.size(); }
+    // Every name by id, for resolving a batch of ids with one snapshot
+    std::vector<std::string> getCategoryNames() const { return snapshot()->categoryNames; }
+    
+    // Counters of the current rule set's memo (a reload starts a fresh one)
+    CategoryCacheStats getCacheStats() const { return snapshot()->cache.stats(); }
+    
     // Get all categories
-    const std::vector<CategoryRule>& getCategories() const { return categories; }
+    std::vector<CategoryRule> getCategories() const { return snapshot()->rules; }
+    std::vector<std::pair<std::string, std::string>> getMerchantOverrides() const {
+        return snapshot()->overrides;
+    }
+    
+    // Rules and overrides of the current rule set
+    CategoryConfig getConfig() const;
+    
+    // Text fragments that bound what changed between two configurations: a transaction
+    // whose description contains none of them is categorized the same under both. Returns
+    // false when no such bound exists (e.g. a changed rule without keywords), meaning every
+    // transaction has to be re-evaluated.
+    static bool changedKeywords(const CategoryConfig& before, const CategoryConfig& after,
+                                std::vector<std::string>& keywords);
     
     // Reload default categories if file not found
     void loadDefaultCategories();
     
 private:
-    std::vector<CategoryRule> categories;
-    void addCategory(const std::string& name, const std::vector<std::string>& keywords);
-    std::string toLower(const std::string& str) const;
+    // One immutable, fully compiled rule set together with its memo
+    struct RuleSet {
+        std::vector<CategoryRule> rules;
+        std::vector<std::pair<std::string, std::string>> overrides;
+        RuleProgram program;
+        MappedFile mapping;  // Backs `program` when it was attached from a rule cache
+        bool fromCache = false;
+        uint64_t version = 0;
+        std::vector<std::string> categoryNames;  // Indexed by CategoryId; "Other" first
+        std::vector<CategoryId> ruleCategory;    // Rule index -> CategoryId
+        std::unordered_map<std::string, CategoryId> overrideIds;
+        mutable CategoryCache cache;
+    };
+    
+    // Read with std::atomic_load, replaced with std::atomic_store
+    std::shared_ptr<const RuleSet> current;
+    std::mutex publishMutex;  // Serializes publishers only; readers never take it
+    
+    std::thread watcher;
+    int stopPipe[2];
+    std::mutex callbackMutex;
+    ReloadCallback reloadCallback;
+    
+    std::shared_ptr<const RuleSet> snapshot() const { return std::atomic_load(&current); }
+    void publish(std::shared_ptr<RuleSet> next);
+    bool loadRuleSet(const std::string& filePath, std::string& error);
+    void watchLoop(int inotifyFd, std::string filePath, std::string fileName);
+    
+    static CategoryId categorize(const RuleSet& set, const CategorizationInput& input);
+    static std::string cacheKey(const RuleSet& set, const CategorizationInput& input);
+    static std::shared_ptr<RuleSet> loadRuleCache(const std::string& cachePath,
+                                                  uint64_t sourceHash);
+    static void saveRuleCache(const RuleSet& set, const std::string& cachePath,
+                              uint64_t sourceHash);
+    static void addCategory(std::vector<CategoryRule>& rules, const std::string& name,
+                            const std::vector<std::string>& keywords);
 };
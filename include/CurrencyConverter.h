@@ -0,0 +1,60 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "CSVParser.h"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Converts amounts into one reporting currency using a date-indexed FX table.
+// Rates are "reporting-currency units per unit of the foreign currency" and are expanded into
+// one dense array per currency covering every day between its first and last quoted date,
+// with weekends and holidays carrying the previous quote forward. A lookup is then a single
+// subtraction and clamp; dates before the first quote use the first quote, dates after the
+// last use the last.
+class CurrencyConverter {
+public:
+    explicit CurrencyConverter(const std::string& reportingCurrency = "USD");
+    
+    // CSV with a header row and columns date,currency,rate. Throws std::runtime_error naming
+    // the line of the first bad date or rate.
+    void loadRates(const std::string& filePath);
+    void addRate(const std::string& date, const std::string& currency, double rate);
+    
+    const std::string& getReportingCurrency() const { return reportingCurrency; }
+    bool hasRates(const std::string& currency) const;
+    double getRate(const std::string& currency, int dayNumber) const;
+    
+    // Batch conversion of one currency's amounts: gathers the rate of each day number into a
+    // factor column and multiplies in a single pass over the contiguous arrays. When `factors`
+    // is given the rates used are left in it.
+    void convert(const std::string& currency, const int* dayNumbers, double* amounts,
+                 size_t count, double* factors = nullptr) const;
+    
+    // Converts every row whose currency differs from the reporting currency and records the
+    // rate used in Transaction::fxRate. Throws std::runtime_error for unknown currencies.
+    void convert(std::vector<Transaction>& transactions) const;
+    
+    // "$", "€", "£", "¥", otherwise the ISO code followed by a space
+    static std::string symbol(const std::string& currency);
+    
+    // Upper-cased ISO code with whitespace removed
+    static std::string normalizeCode(const std::string& currency);
+    
+private:
+    struct RateTable {
+        int firstDay = 0;
+        std::vector<double> daily;
+        std::vector<std::pair<int, double>> quotes;
+    };
+    
+    std::string reportingCurrency;
+    std::map<std::string, RateTable> tables;
+    
+    const RateTable& table(const std::string& currency) const;
+    static void rebuild(RateTable& table);
+};
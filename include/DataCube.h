@@ -0,0 +1,88 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "TransactionData.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class CubeAxis { Category, Account, Period };
+
+struct CubeCell {
+    double spending = 0.0;  // Sum of negative amounts (<= 0)
+    double income = 0.0;    // Sum of positive amounts
+    uint32_t count = 0;
+    
+    void add(const CubeCell& other) {
+        spending += other.spending;
+        income += other.income;
+        count += other.count;
+    }
+};
+
+// Dense category x account x month aggregate, built in one pass over the transactions.
+// Labels on every axis are interned and sorted; months run contiguously from the earliest to
+// the latest dated transaction. Rows without a parseable date still count toward category and
+// account roll-ups but sit outside the period axis.
+// Cells are laid out so each (category, account) pair owns a contiguous run of months.
+class DataCube {
+public:
+    static constexpr size_t npos = SIZE_MAX;
+    
+    // Rows set in `excluded` (e.g. matched transfers) are left out of every cell
+    explicit DataCube(const TransactionData& data, const std::vector<bool>& excluded = {});
+    
+    size_t size(CubeAxis axis) const;
+    const std::vector<std::string>& labels(CubeAxis axis) const;
+    size_t find(CubeAxis axis, const std::string& label) const;
+    
+    const CubeCell& cell(size_t category, size_t account, size_t period) const {
+        return cells[offset(category, account) + period];
+    }
+    
+    // Monthly cells for one (category, account) pair, size(CubeAxis::Period) long
+    const CubeCell* series(size_t category, size_t account) const {
+        return &cells[offset(category, account)];
+    }
+    
+    CubeCell total() const;
+    
+    // Copy of this cube with the rows in `changes` moved from their old category to the new
+    // one, as if rebuilt from `data` (which must otherwise be what this cube was built from,
+    // with the same exclusions). Returns nullptr when the category axis itself would change,
+    // i.e. a category gains its first row or loses its last; rebuild in that case.
+    std::shared_ptr<DataCube> withCategoryChanges(const TransactionData& data,
+                                                  const std::vector<CategoryChange>& changes,
+                                                  const std::vector<bool>& excluded = {}) const;
+    
+    // Marginal totals along one axis
+    std::vector<CubeCell> rollUp(CubeAxis axis) const;
+    
+    // Row-major size(rows) x size(columns) matrix with the remaining axis summed out
+    std::vector<CubeCell> pivot(CubeAxis rows, CubeAxis columns) const;
+    
+    // As pivot, but with the remaining axis fixed at `index` instead of summed
+    std::vector<CubeCell> slice(CubeAxis fixed, size_t index, CubeAxis rows,
+                                CubeAxis columns) const;
+    
+private:
+    std::vector<std::string> axisLabels[3];
+    std::unordered_map<std::string, size_t> axisIndex[3];
+    
+    // One extra trailing slot per (category, account) holds undated rows
+    int firstMonth;
+    size_t periodSlots;
+    std::vector<CubeCell> cells;
+    
+    size_t offset(size_t category, size_t account) const {
+        return (category * axisLabels[1].size() + account) * periodSlots;
+    }
+    
+    template <typename Visit>
+    void forEachCell(Visit visit) const;
+};
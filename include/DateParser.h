@@ -21,6 +21,15 @@ public:
     // Extract month from normalized date (YYYY-MM)
     static std::string extractMonth(const std::string& dateStr);
     
+    // Convert a normalized YYYY-MM-DD date to days since 1970-01-01 and back.
+    // Cheap enough to call per transaction; throws std::invalid_argument on malformed input.
+    static int toDayNumber(const std::string& normalizedDate);
+    static std::string fromDayNumber(int dayNumber);
+    
+    // As toDayNumber, but reports malformed input by returning false, for per-row loops that
+    // skip undated rows
+    static bool tryDayNumber(const std::string& normalizedDate, int& dayNumber);
+    
 private:
     static int detectFormat(const std::string& dateStr);
     static bool isValidDate(int year, int month, int day);
@@ -0,0 +1,32 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Set of 64-bit fingerprints in one flat open-addressing table (linear probing, power-of-two
+// capacity, at most half full). Slot value 0 marks an empty slot, so a fingerprint of 0 is
+// stored as 1; fingerprints are expected to be well-mixed hashes.
+class FingerprintSet {
+public:
+    explicit FingerprintSet(size_t expected = 0);
+    
+    // Returns false when the fingerprint was already present
+    bool insert(uint64_t fingerprint);
+    bool contains(uint64_t fingerprint) const;
+    
+    void reserve(size_t expected);
+    void clear();
+    size_t size() const { return count; }
+    
+private:
+    std::vector<uint64_t> slots;
+    size_t count;
+    size_t mask;
+    
+    static uint64_t key(uint64_t fingerprint) { return fingerprint == 0 ? 1 : fingerprint; }
+    void rehash(size_t capacity);
+};
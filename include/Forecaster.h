@@ -0,0 +1,44 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "DataCube.h"
+#include "TransactionData.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct SpendingForecast {
+    std::string category;
+    std::string accountName;
+    std::string method;          // "Holt-Winters", "Holt" or "Mean"
+    std::vector<double> values;  // Expected spending (positive) for each forecast month
+};
+
+struct ForecastResult {
+    std::vector<std::string> months;  // YYYY-MM labels of the forecast horizon
+    std::vector<SpendingForecast> groups;
+};
+
+// Batched exponential-smoothing forecaster. All (category, account) groups are laid out as
+// contiguous rows of one monthly matrix and fitted in parallel: additive Holt-Winters with a
+// 12-month season once two years of history exist, damped Holt otherwise. Smoothing
+// parameters are chosen per group by a small grid search on one-step-ahead error.
+class SpendingForecaster {
+public:
+    explicit SpendingForecaster(size_t horizon = 3);
+
+    ForecastResult forecast(const TransactionData& data) const;
+    ForecastResult forecast(const DataCube& cube) const;
+
+    // Core batch entry point: `series` holds `groups` rows of `months` values each.
+    // Returns `groups` rows of `horizon` values; methods[g] names the model chosen for row g.
+    std::vector<double> forecastMatrix(const std::vector<double>& series, size_t groups,
+                                       size_t months, std::vector<std::string>* methods) const;
+
+    size_t getHorizon() const { return horizon; }
+
+private:
+    size_t horizon;
+};
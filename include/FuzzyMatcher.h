@@ -0,0 +1,84 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "CategoryCache.h"
+#include "CategoryFallback.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class TransactionData;
+
+// Matches merchant keys (see normalizeMerchant) against a dictionary of known merchants by
+// the Jaccard similarity of their character trigrams, so "blue botle" or "bluebottle coffee"
+// still finds "blue bottle".
+//
+// Trigrams are packed into 24-bit integers and indexed as sorted posting lists. A lookup only
+// walks the postings of its rarest n - ceil(t * n) + 1 trigrams: any merchant reaching
+// similarity t shares at least ceil(t * n) of the query's n trigrams, so it must appear in
+// one of them. Candidates are then size-filtered and verified by merging sorted trigram
+// lists. Results are memoized per merchant key.
+class FuzzyMatcher : public CategoryFallback {
+public:
+    static constexpr double kDefaultThreshold = 0.5;
+    static constexpr uint32_t npos = UINT32_MAX;
+    
+    explicit FuzzyMatcher(double threshold = kDefaultThreshold);
+    FuzzyMatcher(const FuzzyMatcher&) = delete;
+    FuzzyMatcher& operator=(const FuzzyMatcher&) = delete;
+    
+    // Adds a merchant (normalized here); the first category given for a merchant wins.
+    // Takes effect at the next build().
+    void add(std::string_view merchant, const std::string& category);
+    
+    // Each merchant's most frequent category among already categorized rows
+    void addHistory(const TransactionData& data, const std::string& uncategorized = "Other");
+    
+    // CSV of merchant,category (split at the last comma; blank and '#' lines skipped).
+    // Returns the number of lines read; throws std::runtime_error on unreadable input.
+    size_t loadDictionary(const std::string& filePath);
+    
+    // (Re)builds the trigram index and clears the memo
+    void build();
+    
+    size_t size() const { return merchants.size(); }
+    double getThreshold() const { return threshold; }
+    
+    // Category of the most similar dictionary merchant at or above the threshold, or an
+    // empty string. Requires build().
+    std::string match(const std::string& merchant) const;
+    
+    std::vector<std::string> suggest(const std::vector<const Transaction*>& rows) const override;
+    
+    // Memo statistics
+    CategoryCacheStats getCacheStats() const { return cache.stats(); }
+    
+private:
+    double threshold;
+    
+    std::vector<std::string> merchants;
+    std::vector<uint32_t> merchantCategory;
+    std::unordered_map<std::string, uint32_t> merchantIds;
+    std::vector<std::string> categories;
+    std::unordered_map<std::string, uint32_t> categoryIds;
+    
+    // Per merchant: sorted distinct trigrams, CSR
+    std::vector<uint32_t> gramStart;
+    std::vector<uint32_t> grams;
+    
+    // Per trigram: ascending merchant ids, CSR over the sorted distinct trigrams
+    std::vector<uint32_t> trigramKeys;
+    std::vector<uint32_t> postingStart;
+    std::vector<uint32_t> postings;
+    
+    mutable CategoryCache cache;
+    
+    // Dictionary category id, or npos
+    uint32_t lookup(const std::string& merchant) const;
+    static void trigrams(std::string_view merchant, std::vector<uint32_t>& out);
+};
@@ -0,0 +1,38 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace mt {
+
+// Finalizer from MurmurHash3: spreads every input bit over the whole 64-bit word
+inline uint64_t mixHash(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// FNV-1a over the bytes followed by mixHash; fast for short keys such as merchant names.
+// Not suitable where an adversary controls the input.
+inline uint64_t hashBytes(std::string_view bytes, uint64_t seed = 0) {
+    uint64_t h = 0xcbf29ce484222325ULL ^ mixHash(seed);
+    for (unsigned char c : bytes) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return mixHash(h);
+}
+
+// Order-dependent combination of two hashes
+inline uint64_t combineHash(uint64_t seed, uint64_t value) {
+    return mixHash(seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
+} // namespace mt
@@ -0,0 +1,54 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct HeavyHitter {
+    std::string key;
+    double weight;  // Estimated total; never underestimates the true value
+    double error;   // Maximum overestimate, so the true total is >= weight - error
+};
+
+// Weighted Space-Saving summary: tracks the heaviest keys of a stream in a fixed number of
+// counters. Any key whose true weight exceeds total / capacity is guaranteed to be present.
+// Summaries built over separate chunks can be merged (Agarwal et al., mergeable summaries).
+class SpaceSaving {
+public:
+    explicit SpaceSaving(size_t capacity = 1024);
+
+    // `order` points into `counters`, so copies rebuild it; moves keep the map nodes
+    SpaceSaving(const SpaceSaving& other);
+    SpaceSaving& operator=(const SpaceSaving& other);
+    SpaceSaving(SpaceSaving&&) = default;
+    SpaceSaving& operator=(SpaceSaving&&) = default;
+
+    void add(const std::string& key, double weight = 1.0);
+    void merge(const SpaceSaving& other);
+
+    // Heaviest `limit` keys, largest first
+    std::vector<HeavyHitter> top(size_t limit) const;
+
+    size_t size() const { return counters.size(); }
+    size_t capacity() const { return maxCounters; }
+
+private:
+    struct Counter {
+        double weight;
+        double error;
+    };
+
+    size_t maxCounters;
+    std::unordered_map<std::string, Counter> counters;
+    // Ordered by weight; points at the (node-stable) keys of `counters`
+    std::set<std::pair<double, const std::string*>> order;
+
+    double minWeight() const;
+    void update(const std::string& key, double weight, double error);
+};
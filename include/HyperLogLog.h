@@ -0,0 +1,25 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// HyperLogLog distinct counter with 2^precision one-byte registers (4 KiB at the default of
+// 12, about 1.6% standard error). Counters with the same precision merge by register max.
+class HyperLogLog {
+public:
+    explicit HyperLogLog(uint8_t precision = 12);
+
+    void add(std::string_view key);
+    void addHash(uint64_t hash);
+    void merge(const HyperLogLog& other);
+
+    double estimate() const;
+
+private:
+    uint8_t precision;
+    std::vector<uint8_t> registers;
+};
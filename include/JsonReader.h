@@ -0,0 +1,56 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Pull parser over an in-memory JSON document (RFC 8259). Values are read in document
+// order through beginObject/nextMember and beginArray/nextElement, so callers walk the
+// structure they expect and skipValue() everything else. Strings without escapes are
+// returned as views into the document; escaped strings are decoded into one reused buffer.
+// A view stays valid until the next read. Malformed input throws std::runtime_error naming
+// the byte offset.
+class JsonReader {
+public:
+    enum class Type { Object, Array, String, Number, Boolean, Null, End };
+    
+    explicit JsonReader(std::string_view document);
+    
+    // Type of the next value (End once the document has been consumed)
+    Type peek();
+    
+    void beginObject();
+    // Reads the next member's key; returns false (consuming the '}') when the object ends
+    bool nextMember(std::string_view& key);
+    
+    void beginArray();
+    // Returns false (consuming the ']') when the array ends
+    bool nextElement();
+    
+    std::string_view readString();
+    double readNumber();
+    bool readBoolean();
+    void readNull();
+    void skipValue();
+    
+    size_t offset() const { return pos; }
+    
+private:
+    std::string_view text;
+    size_t pos;
+    std::vector<bool> pendingComma;  // Per open container: an element was already read
+    std::string scratch;
+    
+    void skipWhitespace();
+    char next();
+    void expect(char c);
+    void expectWord(std::string_view word);
+    bool closeOrSeparate(char close);
+    uint32_t readHex4();
+    [[noreturn]] void fail(const std::string& what) const;
+};
@@ -0,0 +1,69 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Aho-Corasick automaton over (keyword, rule index) pairs, compiled into a dense DFA.
+// Bytes are case-folded (ASCII) and compressed into equivalence classes at compile time, so a
+// transition is two table loads. Every state records the lowest rule index of any keyword
+// ending there, which makes a single pass over a description return the same rule a
+// rule-by-rule, keyword-by-keyword substring search would (first rule wins). States also keep
+// the rules of the keywords ending exactly there, chained by dictionary suffix links, so
+// matchAll() can report every rule with a keyword in the text from the same single pass.
+class KeywordMatcher {
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+    
+    KeywordMatcher();
+    
+    // Move-only: after attach() the tables may live in memory the matcher does not own
+    KeywordMatcher(const KeywordMatcher&) = delete;
+    KeywordMatcher& operator=(const KeywordMatcher&) = delete;
+    KeywordMatcher(KeywordMatcher&&) = default;
+    KeywordMatcher& operator=(KeywordMatcher&&) = default;
+    
+    // keywords[r] holds the keywords of rule r; earlier rules take priority
+    void compile(const std::vector<std::vector<std::string>>& keywords);
+    
+    // Lowest rule index with a keyword occurring in text, or npos
+    uint32_t match(std::string_view text) const;
+    
+    // Sets bit r of `rules` (one bit per rule, 64 per word) for every rule r with a keyword
+    // occurring in text. Existing bits are left set.
+    void matchAll(std::string_view text, uint64_t* rules) const;
+    
+    size_t stateCount() const { return states; }
+    
+    // Appends the compiled automaton as 32-bit words (native byte order)
+    void serialize(std::vector<uint32_t>& out) const;
+    // Uses an automaton written by serialize() in place, without copying the tables. The
+    // words must outlive the matcher (or the next compile/attach). Returns the number of
+    // words consumed, or 0 if they do not hold a well-formed automaton over ruleCount rules.
+    size_t attach(const uint32_t* words, size_t count, uint32_t ruleCount);
+    
+private:
+    uint8_t byteClass[256];
+    uint32_t classCount;
+    uint32_t emptyRule;                 // Lowest rule with an empty keyword (matches anything)
+    std::vector<uint32_t> transitions;  // stateCount() x classCount, when compiled here
+    std::vector<uint32_t> output;       // Lowest rule index matched on reaching each state
+    std::vector<uint32_t> ruleStart;    // CSR offsets into ruleList, stateCount() + 1 entries
+    std::vector<uint32_t> ruleList;     // Rules of keywords ending at a state; state 0 = empty
+    std::vector<uint32_t> dictLink;     // Nearest proper suffix state with rules, 0 if none
+    
+    // The tables match() reads: the vectors above, or attached external memory
+    const uint32_t* table;
+    const uint32_t* outputs;
+    const uint32_t* ruleStarts;
+    const uint32_t* ruleLists;
+    const uint32_t* dictLinks;
+    uint32_t states;
+    
+    void bindOwnedTables();
+};
@@ -0,0 +1,32 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file (POSIX mmap). Move-only; unmaps on destruction.
+class MappedFile {
+public:
+    MappedFile() : base(nullptr), length(0) {}
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    
+    // Returns false (leaving the mapping empty) if the file cannot be opened or mapped
+    bool open(const std::string& path);
+    void close();
+    
+    const uint8_t* data() const { return static_cast<const uint8_t*>(base); }
+    size_t size() const { return length; }
+    bool isOpen() const { return base != nullptr; }
+    
+private:
+    void* base;
+    size_t length;
+};
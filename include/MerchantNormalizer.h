@@ -0,0 +1,28 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+struct Transaction;
+
+// Canonical merchant key for grouping bank descriptions, built in one pass over the bytes:
+//   "SQ *BLUE BOTTLE 0423 SAN FRANCISCO CA" -> "blue bottle"
+//   "AMZN MKTP US*2K4L19"                   -> "amzn mktp"
+//   "POS DEBIT STARBUCKS #1234 XXXX5678"    -> "starbucks"
+// Letters are lowercased and punctuation separates words. Dropped: tokens carrying digits
+// (store numbers, dates, phone numbers, reference codes), masked card numbers, leading
+// transaction-type words, payment-processor prefixes ahead of a '*', and a trailing US state
+// code together with the city between it and the last store number or wide gap.
+// Every word of the key appears in the description, so a key never matches text the
+// description does not contain.
+std::string normalizeMerchant(std::string_view description);
+
+// Process-wide pool of merchant keys: equal keys share one string, and references stay valid
+// until exit. Thread-safe.
+const std::string& internMerchant(std::string_view key);
+
+// The interned key stored on a transaction, or its description normalized and interned
+const std::string& merchantKey(const Transaction& transaction);
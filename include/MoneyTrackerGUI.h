@@ -52,12 +52,15 @@ private:
     static void on_analyze(GtkWidget* widget, gpointer data);
     static void on_open_excel(GtkWidget* widget, gpointer data);
     static gboolean on_window_close(GtkWidget* widget, GdkEvent* event, gpointer data);
+    static gboolean on_rules_reloaded(gpointer data);
     
     // Helper methods
     void build_ui();
     void update_file_list();
     void run_analysis();
     void display_results();
+    void apply_reloaded_rules(bool loaded, const std::string& message,
+                              const CategoryConfig& previous);
     void show_error(const std::string& message);
     void show_info(const std::string& message);
 };
@@ -0,0 +1,72 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "CategoryFallback.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class TransactionData;
+
+// Multinomial naive Bayes over hashed description features, trained from rows that are
+// already categorized. Each token (a run of letters, lowercased; tokens with digits are
+// skipped) and each pair of adjacent tokens is hashed into one of 2^bits buckets, so the model
+// is a fixed table with no strings in it: row b holds every category's log-likelihood for
+// bucket b, padded to a multiple of 8 floats. Scoring a description adds one contiguous row
+// per feature to the per-category scores, a loop the compiler vectorizes.
+//
+// The table is saved as a compact binary file (native u32 words with a payload hash); at the
+// default 14 bits that is 64 KiB per category.
+class NaiveBayesClassifier : public CategoryFallback {
+public:
+    static constexpr uint32_t kDefaultBits = 14;
+    static constexpr double kDefaultConfidence = 0.9;
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    explicit NaiveBayesClassifier(uint32_t bits = kDefaultBits);
+
+    // Fits the model to every row with a category other than `uncategorized`, replacing any
+    // previous model. Returns the number of rows trained on. Rows spanning fewer than two
+    // categories leave the model untrained and return 0: a lone category would take every
+    // posterior.
+    size_t train(const TransactionData& data, const std::string& uncategorized = "Other");
+
+    // Throws std::runtime_error when the file cannot be written
+    void save(const std::string& filePath) const;
+
+    // False (leaving the model untouched) when the file is missing or not a valid trained model
+    bool load(const std::string& filePath);
+
+    // Minimum posterior probability for classify() and suggest() to answer
+    void setConfidence(double threshold) { confidence = threshold; }
+    double getConfidence() const { return confidence; }
+
+    uint32_t getBits() const { return bits; }
+    const std::vector<std::string>& getCategories() const { return categories; }
+    bool isTrained() const { return categories.size() >= 2; }
+
+    // Most probable category index (npos for an untrained model) and its posterior
+    // probability for each description
+    void classifyBatch(const std::string_view* descriptions, size_t count, uint32_t* best,
+                       float* probability) const;
+
+    // Most probable category if it reaches the confidence threshold, else an empty string
+    std::string classify(std::string_view description) const;
+
+    std::vector<std::string> suggest(const std::vector<const Transaction*>& rows) const override;
+
+private:
+    uint32_t bits;
+    size_t stride;  // categories.size() rounded up to a multiple of 8
+    double confidence;
+
+    std::vector<std::string> categories;
+    std::vector<float> priors;   // stride entries; padding columns never win
+    std::vector<float> weights;  // (1 << bits) rows of stride log-likelihoods
+
+    void resize(size_t categoryCount);
+};
@@ -0,0 +1,32 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace mt {
+
+// Number of threads in the shared pool (hardware concurrency, at least 1)
+size_t workerCount();
+
+// Split [0, count) into at most workerCount() contiguous [begin, end) ranges of at least
+// minChunk items each. Always returns at least one range (possibly empty).
+std::vector<std::pair<size_t, size_t>> partition(size_t count, size_t minChunk);
+
+// Run task(i) for every i in [0, tasks) on the shared thread pool and wait for completion.
+// The calling thread takes part in the work, so nested calls from inside a task are safe.
+// The first exception thrown by a task is rethrown once all tasks have finished.
+void parallelInvoke(size_t tasks, const std::function<void(size_t)>& task);
+
+// Convenience wrapper: run fn(begin, end) over the ranges produced by partition()
+void parallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)>& fn);
+
+// In-place inclusive prefix sum. Chunks of at least minChunk values are scanned in parallel,
+// their totals scanned serially, and the offsets added back in a second parallel pass.
+void parallelInclusiveScan(double* values, size_t count, size_t minChunk);
+
+} // namespace mt
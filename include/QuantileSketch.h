@@ -0,0 +1,38 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Mergeable KLL quantile sketch. Retains roughly 3k values regardless of stream length,
+// with a rank error of about 1.7 / k. Sketches built over separate chunks can be merged.
+class QuantileSketch {
+public:
+    explicit QuantileSketch(uint32_t k = 200);
+
+    void add(double value);
+    void merge(const QuantileSketch& other);
+
+    // Approximate value at quantile q in [0, 1]; 0 when the sketch is empty
+    double quantile(double q) const;
+
+    uint64_t count() const { return n; }
+    size_t retainedItems() const { return retained; }
+
+private:
+    uint32_t k;
+    uint64_t n;
+    size_t retained;
+    size_t budget;  // totalCapacity() for the current number of levels
+    bool coin;  // Alternates which half of a level survives compaction
+
+    // Items in levels[h] each stand for 2^h values of the stream
+    std::vector<std::vector<double>> levels;
+
+    size_t capacity(size_t level) const;
+    size_t totalCapacity() const;
+    void compress();
+};
@@ -0,0 +1,77 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "RecurringDetector.h"
+#include "TransactionData.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+enum class ReconciliationIssue {
+    BalanceGap,        // Reported balance moved by more than the transactions explain
+    Duplicate,         // Same day, amount and description with no balance movement between
+    MissingStatement   // No activity for longer than a statement cycle
+};
+
+struct ReconciliationFlag {
+    ReconciliationIssue issue;
+    std::string date;
+    std::string description;
+    double amount;      // Unexplained balance change, duplicated amount, or 0 (statement currency)
+    int days;           // Length of a missing-statement gap, otherwise 0
+};
+
+// Balances and flag amounts are in the account's statement currency, like Transaction::balance
+struct AccountReconciliation {
+    std::string accountName;
+    std::string currency;         // Statement currency; empty means the reporting currency
+    size_t transactions = 0;
+    std::string firstDate;
+    std::string lastDate;
+    bool hasBalances = false;     // At least one row reported a balance
+    double openingBalance = 0.0;  // Balance before the first transaction
+    double closingBalance = 0.0;  // Latest reported balance, or opening plus all activity
+    std::vector<ReconciliationFlag> flags;
+};
+
+struct CashFlowPoint {
+    std::string date;
+    std::string description;
+    double amount;
+    double balance;
+};
+
+// In the account's statement currency (see AccountReconciliation)
+struct CashFlowProjection {
+    std::string accountName;
+    std::string currency;
+    double startingBalance = 0.0;
+    double lowestBalance = 0.0;
+    std::string lowestDate;
+    std::vector<CashFlowPoint> points;
+};
+
+// Per-account reconciliation of Transaction::balance against the computed running balance.
+// Each account's rows are sorted by date (stable, so statement order breaks ties) and the
+// running balance is a parallel prefix sum; comparing its offset from the reported column
+// row to row pins each gap to the first row it shows up on. Accounts run in parallel.
+class Reconciler {
+public:
+    explicit Reconciler(double tolerance = 0.01, int statementGapDays = 35);
+    
+    std::vector<AccountReconciliation> reconcile(const TransactionData& data) const;
+    
+    // Expected balances over the next `days` days from the active recurring series, scanned
+    // forward from each account's closing balance with the same prefix-sum pass
+    std::vector<CashFlowProjection>
+    projectCashFlow(const std::vector<AccountReconciliation>& accounts,
+                    const std::vector<RecurringSeries>& recurring, int days = 90) const;
+    
+    static std::string issueName(ReconciliationIssue issue);
+    
+private:
+    double tolerance;
+    int statementGapDays;
+};
@@ -0,0 +1,49 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "TransactionData.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+enum class RecurrencePeriod { Weekly, Monthly, Annual };
+
+struct RecurringSeries {
+    std::string merchant;
+    std::string accountName;
+    std::string category;     // Category of the latest occurrence
+    RecurrencePeriod period;
+    size_t occurrences;
+    double averageAmount;     // Signed, like Transaction::amount
+    std::string firstDate;
+    std::string lastDate;
+    std::string nextExpectedDate;
+    double nextExpectedAmount;
+    double nextStatementAmount;  // nextExpectedAmount in the account's statement currency
+    bool active;              // Last seen within 1.5 periods of the newest transaction
+};
+
+// Finds recurring charges (subscriptions, rent, payroll) without relying on keywords.
+// Rows are keyed by a hash of (normalized merchant, account, sign) and sorted by amount; each
+// key's run is cut into clusters of similar amounts, which are then put in date order. That is
+// O(N log N) sorting plus a linear scan.
+class RecurringDetector {
+public:
+    // amountTolerance is the relative width of an amount cluster (0.10 groups amounts within ~10%)
+    explicit RecurringDetector(size_t minOccurrences = 3, double amountTolerance = 0.10);
+
+    // Rows set in `excluded` (e.g. matched transfers) are never part of a series
+    std::vector<RecurringSeries> detect(const TransactionData& data,
+                                        const std::vector<bool>& excluded = {}) const;
+
+    static std::string periodName(RecurrencePeriod period);
+
+    // Calendar-aware step so monthly charges stay on their day of month
+    static std::string nextDate(const std::string& date, RecurrencePeriod period);
+
+private:
+    size_t minOccurrences;
+    double amountTolerance;
+};
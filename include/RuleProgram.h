@@ -0,0 +1,117 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "KeywordMatcher.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct CategoryRule {
+    std::string category;               // May be a '/'-separated path such as "Food/Dining/Coffee"
+    std::vector<std::string> keywords;  // Any of these keywords triggers the category
+    
+    // Optional conditions. A rule matches when every condition it sets holds; a rule with no
+    // keywords relies on the other conditions alone.
+    std::string pattern;                // ECMAScript regex searched in the description, any case
+    double minAmount = -std::numeric_limits<double>::infinity();  // Inclusive, signed
+    double maxAmount = std::numeric_limits<double>::infinity();
+    std::string account;                // Exact account name
+    std::string startDate;              // YYYY-MM-DD, inclusive; empty = unbounded
+    std::string endDate;
+    
+    bool hasAmountRange() const {
+        return minAmount != -std::numeric_limits<double>::infinity() ||
+               maxAmount != std::numeric_limits<double>::infinity();
+    }
+    bool hasConditions() const {
+        return !keywords.empty() || !pattern.empty() || hasAmountRange() || !account.empty() ||
+               !startDate.empty() || !endDate.empty();
+    }
+};
+
+// What a rule can look at. Unknown fields fail every condition on them.
+struct CategorizationInput {
+    std::string_view description;
+    double amount = std::numeric_limits<double>::quiet_NaN();
+    std::string_view account;
+    std::string_view date;              // YYYY-MM-DD
+    const std::string* merchant = nullptr;  // Interned merchant key, when already known
+};
+
+// Rules compiled into a decision program. Work shared by all rules happens once per input:
+// the account is resolved to a candidate mask and the keyword automaton reports every rule
+// with a keyword hit in one pass. Candidates are then visited in rule order, testing the
+// integer amount (cents) and date (yyyymmdd) ranges before any regex, and the first rule to
+// pass wins. Keyword-only rule sets skip all of this and use KeywordMatcher::match directly.
+class RuleProgram {
+public:
+    static constexpr uint32_t npos = KeywordMatcher::npos;
+    
+    RuleProgram();
+    
+    // Throws std::invalid_argument for an invalid pattern or date
+    void compile(const std::vector<CategoryRule>& rules);
+    // As compile(), but reuses an automaton written by serialize() (see KeywordMatcher::attach).
+    // Returns false, leaving the program unchanged, if the words do not fit the rules.
+    bool attach(const std::vector<CategoryRule>& rules, const uint32_t* words, size_t count);
+    void serialize(std::vector<uint32_t>& out) const { matcher.serialize(out); }
+    
+    // Index of the first matching rule, or npos
+    uint32_t evaluate(const CategorizationInput& input) const;
+    
+    // Appends a compact signature of the non-description inputs evaluate() depends on, so
+    // description + signature is a sound memoization key
+    void appendContext(const CategorizationInput& input, std::string& key) const;
+    
+    // Whether digits in a description can change the outcome (a keyword or pattern uses them)
+    bool usesDigits() const { return digitsMatter; }
+    bool isKeywordOnly() const { return keywordOnly; }
+    size_t stateCount() const { return matcher.stateCount(); }
+    
+    // yyyymmdd for a YYYY-MM-DD date, or -1
+    static int32_t dateKey(std::string_view date);
+    
+private:
+    static constexpr int64_t kNoCents = std::numeric_limits<int64_t>::min();
+    
+    enum StepFlags : uint32_t { kAmount = 1, kDate = 2, kPattern = 4 };
+    
+    struct Step {
+        uint32_t flags;
+        uint32_t pattern;               // Index into patterns
+        int64_t minCents;
+        int64_t maxCents;
+        int32_t firstDay;
+        int32_t lastDay;
+    };
+    
+    KeywordMatcher matcher;
+    std::vector<Step> steps;
+    std::vector<std::regex> patterns;
+    size_t words;                       // 64-bit words per rule bitset
+    
+    // Rules with no keywords are always candidates; the automaton adds the others
+    std::vector<uint64_t> keywordFree;
+    // Row per account id (0 = an account no rule names): rules allowed for that account
+    std::unordered_map<std::string, uint32_t> accountIds;
+    std::vector<uint64_t> accountMasks;
+    
+    // Sorted range boundaries; the interval an input falls in decides every range test
+    std::vector<int64_t> amountBounds;
+    std::vector<int64_t> dateBounds;
+    
+    bool keywordOnly;
+    bool hasKeywords;
+    bool digitsMatter;
+    
+    void build(const std::vector<CategoryRule>& rules);
+    uint32_t accountId(std::string_view account) const;
+    static int64_t cents(double amount);
+};
@@ -33,10 +33,31 @@ public:
                             const BudgetAnalyzer& analyzer,
                             const std::string& outputPath);
     
+    // Months covered by the Forecast sheet; 0 omits the sheet
+    void setForecastMonths(size_t months) { forecastMonths = months; }
+    
+    // Currency symbol used by every money column (default USD)
+    void setReportingCurrency(const std::string& currency);
+    
 private:
+    size_t forecastMonths = 3;
+    std::string reportingCurrency = "USD";
+    std::string currencyFormat;
+    
+    // Excel number format for amounts in the given currency (empty means reporting)
+    std::string numberFormat(const std::string& currency) const;
+    
     bool createSummarySheet(void* workbook, const BudgetAnalyzer& analyzer);
     bool createTransactionSheet(void* workbook, const TransactionData& data);
     bool createCategorySheet(void* workbook, const TransactionData& data, const BudgetAnalyzer& analyzer);
     bool createMonthlySheet(void* workbook, const TransactionData& data, const BudgetAnalyzer& analyzer);
+    bool createMerchantSheet(void* workbook, const BudgetAnalyzer& analyzer);
+    bool createRecurringSheet(void* workbook, const BudgetAnalyzer& analyzer);
+    bool createForecastSheet(void* workbook, const BudgetAnalyzer& analyzer);
+    bool createReconciliationSheet(void* workbook, const BudgetAnalyzer& analyzer);
+    bool createCashFlowSheet(void* workbook, const BudgetAnalyzer& analyzer);
+    bool createCategoryTreeSheet(void* workbook, const BudgetAnalyzer& analyzer);
+    bool createPivotSheet(void* workbook, const char* name, const DataCube& cube,
+                          CubeAxis rows, CubeAxis columns);
     bool createCharts(void* workbook, const TransactionData& data, const BudgetAnalyzer& analyzer);
 };
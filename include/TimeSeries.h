@@ -0,0 +1,68 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "TransactionData.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class Granularity { Week, Month, Quarter, Year };
+
+// Contiguous per-period spending series for every category, backed by prefix sums.
+// Built in a single O(N) pass; every window query afterwards is O(1).
+// Values follow TransactionData::getMonthlyTotals: the sum of negative amounts (spending <= 0).
+// Periods are indexed from 0 (earliest) to periodCount() - 1 (latest), with no gaps.
+// An empty category name selects the total across all categories.
+class SpendingTimeSeries {
+public:
+    // Rows set in `excluded` (e.g. matched transfers) are left out of every period
+    SpendingTimeSeries(const TransactionData& data, Granularity granularity,
+                       const std::vector<bool>& excluded = {});
+
+    Granularity getGranularity() const { return granularity; }
+    size_t periodCount() const { return periods; }
+    int periodsPerYear() const;
+
+    // Monday date (YYYY-MM-DD) for weeks, otherwise YYYY-MM, YYYY-Qn or YYYY
+    std::string periodLabel(size_t period) const;
+    const std::vector<std::string>& getCategories() const { return categories; }
+
+    // Number of transactions (income included) that fell into a period
+    uint32_t transactionCount(size_t period) const;
+    size_t activePeriodCount() const { return activePeriods; }
+
+    double periodTotal(size_t period, const std::string& category = "") const;
+
+    // Inclusive range [first, last]; out-of-range bounds are clamped
+    double rangeTotal(size_t first, size_t last, const std::string& category = "") const;
+
+    // Window of `window` periods ending at (and including) endPeriod. The window is truncated
+    // at the start of the series, and the average divides by the truncated length.
+    double rollingSum(size_t endPeriod, size_t window, const std::string& category = "") const;
+    double rollingAverage(size_t endPeriod, size_t window, const std::string& category = "") const;
+
+    // Percentage change of `period` against `lag` periods earlier; 0 when there is no base.
+    // Computed on the signed totals, so rising spending reads as a negative change.
+    double periodOverPeriod(size_t period, size_t lag, const std::string& category = "") const;
+    double yearOverYear(size_t period, const std::string& category = "") const;
+
+private:
+    Granularity granularity;
+    int firstKey;
+    size_t periods;
+    size_t activePeriods;
+
+    std::vector<std::string> categories;
+    std::unordered_map<std::string, size_t> categoryIndex;
+
+    // (categories.size() + 1) rows of (periods + 1) prefix sums; the last row is the total
+    std::vector<double> prefix;
+    std::vector<uint32_t> counts;
+
+    const double* row(const std::string& category) const;
+    int periodKey(const std::string& date) const;  // INT_MIN for a malformed date
+};
@@ -0,0 +1,38 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Inverted index from description tokens to row ids. A token is a maximal run of ASCII
+// letters and digits (plus any byte >= 0x80), lowercased. Rows must be added in increasing
+// order, which keeps every posting list sorted without extra work.
+//
+// Keywords match as substrings, not whole tokens, so lookups go through the vocabulary:
+// rowsContaining(fragment) returns every row with a token containing the fragment. Any row
+// whose description contains a keyword has a token containing the keyword's longest token,
+// which makes that a sound candidate filter for substring matches.
+class TokenIndex {
+public:
+    void add(uint32_t row, std::string_view description);
+    void clear();
+    
+    // Sorted, duplicate-free rows with a token containing `fragment` (a lowercase token)
+    std::vector<uint32_t> rowsContaining(std::string_view fragment) const;
+    
+    // Longest token of text, lowercased; empty when text has none
+    static std::string longestToken(std::string_view text);
+    
+    size_t tokenCount() const { return tokens.size(); }
+    
+private:
+    std::unordered_map<std::string, uint32_t> tokenIds;
+    std::vector<std::string> tokens;
+    std::vector<std::vector<uint32_t>> postings;
+};
@@ -20,18 +20,60 @@
 #pragma once
 
 #include "CSVParser.h"
+#include "CategoryFallback.h"
+#include "FingerprintSet.h"
+#include "TokenIndex.h"
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <string>
 #include <memory>
 
+// One row moved between categories by a recategorization
+struct CategoryChange {
+    size_t row;
+    std::string from;
+    std::string to;
+};
+
 class TransactionData {
 public:
     TransactionData();
     ~TransactionData() = default;
     
+    // Appends unconditionally (manual entries)
     void addTransaction(const Transaction& transaction);
-    void addTransactions(const std::vector<Transaction>& transactions);
+    
+    // Ingest path for statement exports. Each row is fingerprinted by account, date, amount in
+    // cents, merchant key (the normalized description when there is none) and its ordinal
+    // among identical rows of the batch, so rows repeated by an overlapping export are dropped
+    // while genuine same-day repeats within one export survive. Returns the number of rows
+    // appended; they are the last rows of getAllTransactions(), in batch order.
+    size_t addTransactions(const std::vector<Transaction>& transactions);
+    
+    // Re-run categorization over every loaded row (e.g. after the rules changed), in one
+    // batch. Returns the number of rows whose category changed.
+    size_t recategorize(const ConfigManager& config);
+    
+    // As above, for rows currently categorized under `previous`: only rows whose description
+    // contains one of the keywords that differ between `previous` and the loaded rules are
+    // re-evaluated, found through the description token index. Falls back to a full pass
+    // when the change cannot be bounded by keywords.
+    size_t recategorize(const ConfigManager& config, const CategoryConfig& previous);
+    
+    // Offer every row still in `uncategorized` to a fallback categorizer, in one batch, and
+    // take its suggestions. Run after (re)categorizing; a full recategorize() resets them.
+    // Returns the number of rows filled.
+    size_t fillUncategorized(const CategoryFallback& fallback,
+                             const std::string& uncategorized = "Other");
+    
+    // Rows moved by the last recategorization or fill, if it is the only mutation since
+    // `sinceVersion`. Lets derived aggregates apply deltas instead of rebuilding.
+    bool getCategoryChanges(uint64_t sinceVersion, std::vector<CategoryChange>& changes) const;
+    
+    // Rows dropped by addTransactions as already present
+    size_t getDuplicateCount() const { return duplicates; }
+    void setDeduplication(bool enabled) { deduplicate = enabled; }
     
     const std::vector<Transaction>& getAllTransactions() const;
     std::vector<Transaction> getTransactionsByCategory(const std::string& category) const;
@@ -47,8 +89,24 @@ public:
     std::vector<std::string> getUniqueCategories() const;
     std::vector<std::string> getUniqueAccounts() const;
     
+    // Monotonically increasing, bumped on every mutation so derived results can be memoized
+    uint64_t getVersion() const { return version; }
+    
 private:
     std::vector<Transaction> transactions;
+    uint64_t version;
+    
+    bool deduplicate;
+    size_t duplicates;
+    FingerprintSet fingerprints;
+    
+    TokenIndex tokenIndex;
+    std::vector<CategoryChange> changeLog;
+    uint64_t changeVersion;  // Version produced by the recategorization in changeLog; 0 = none
     
+    size_t applyCategories(const std::vector<uint32_t>& rows, const ConfigManager& config);
+    size_t assignCategories(const std::vector<uint32_t>& rows,
+                            const std::vector<std::string>& categories);
+    void indexRows(size_t first);
     std::string extractMonth(const std::string& date) const;
 };
@@ -0,0 +1,34 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#pragma once
+
+#include "TransactionData.h"
+#include <cstddef>
+#include <vector>
+
+// Indices into TransactionData::getAllTransactions()
+struct TransferMatch {
+    size_t outflow;
+    size_t inflow;
+    int days;       // inflow date minus outflow date
+};
+
+// Pairs an outflow in one account with an equal inflow in another account within a date
+// window. Legs are compared in their statement currency, so a transfer between two accounts
+// in the same foreign currency still pairs when each leg was converted at its own day's rate.
+// Inflows are hash-partitioned on (currency, amount in cents) into day-sorted buckets;
+// outflows are taken in date order and each probes only its own bucket's window, taking the
+// nearest unmatched inflow. Build and probe are linear apart from the per-bucket sorts.
+class TransferMatcher {
+public:
+    explicit TransferMatcher(int windowDays = 3);
+    
+    std::vector<TransferMatch> match(const TransactionData& data) const;
+    
+    // Row mask with both sides of every match set
+    static std::vector<bool> matchedRows(const std::vector<TransferMatch>& matches, size_t rows);
+    
+private:
+    int windowDays;
+};
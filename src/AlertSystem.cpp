@@ -2,8 +2,15 @@
 //MIT License
 
 #include "AlertSystem.h"
+#include "CurrencyConverter.h"
+#include "MerchantNormalizer.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
 
-AlertSystem::AlertSystem() : overallLimit(0.0) {}
+AlertSystem::AlertSystem()
+    : overallLimit(0.0), currencySymbol("$"), anomalySigmas(5.0), anomalyMinSamples(8) {}
 
 void AlertSystem::setCategoryLimit(const std::string& category, double limit) {
     categoryLimits[category] = limit;
@@ -13,6 +20,11 @@ void AlertSystem::setOverallLimit(double limit) {
     overallLimit = limit;
 }
 
+void AlertSystem::setReportingCurrency(const std::string& currency) {
+    std::lock_guard<std::mutex> lock(ingestMutex);
+    currencySymbol = CurrencyConverter::symbol(currency);
+}
+
 std::vector<Alert> AlertSystem::checkTransactions(const TransactionData& data) {
     alerts.clear();
     
@@ -28,8 +40,8 @@ std::vector<Alert> AlertSystem::checkTransactions(const TransactionData& data) {
             alert.category = limit.first;
             alert.amount = it->second;
             alert.limit = limit.second;
-            alert.message = "Category '" + limit.first + "' exceeded limit: $" + 
-                          std::to_string(static_cast<int>(it->second)) + " / $" + 
+            alert.message = "Category '" + limit.first + "' exceeded limit: " + currencySymbol +
+                          std::to_string(static_cast<int>(it->second)) + " / " + currencySymbol +
                           std::to_string(static_cast<int>(limit.second));
             alerts.push_back(alert);
         }
@@ -42,8 +54,8 @@ std::vector<Alert> AlertSystem::checkTransactions(const TransactionData& data) {
         alert.category = "Overall";
         alert.amount = totalExpenses;
         alert.limit = overallLimit;
-        alert.message = "Overall spending exceeded limit: $" + 
-                       std::to_string(static_cast<int>(totalExpenses)) + " / $" + 
+        alert.message = "Overall spending exceeded limit: " + currencySymbol +
+                       std::to_string(static_cast<int>(totalExpenses)) + " / " + currencySymbol +
                        std::to_string(static_cast<int>(overallLimit));
         alerts.push_back(alert);
     }
@@ -55,3 +67,72 @@ bool AlertSystem::isCategoryExceeded(const std::string& category) const {
     auto it = categoryLimits.find(category);
     return it != categoryLimits.end();
 }
+
+void AlertSystem::setAnomalyThreshold(double sigmas, uint64_t minSamples) {
+    std::lock_guard<std::mutex> lock(ingestMutex);
+    anomalySigmas = sigmas;
+    anomalyMinSamples = std::max<uint64_t>(2, minSamples);
+}
+
+void AlertSystem::setAlertCallback(std::function<void(const Alert&)> callback) {
+    std::lock_guard<std::mutex> lock(ingestMutex);
+    alertCallback = std::move(callback);
+}
+
+std::vector<Alert> AlertSystem::getIngestAlerts() const {
+    std::lock_guard<std::mutex> lock(ingestMutex);
+    return ingestAlerts;
+}
+
+bool AlertSystem::observeTransaction(const Transaction& transaction) {
+    if (transaction.amount >= 0) return false;  // Only charges are screened
+    double charge = std::abs(transaction.amount);
+    const std::string& merchant = merchantKey(transaction);
+    
+    std::function<void(const Alert&)> callback;
+    Alert alert;
+    bool flagged = false;
+    {
+        std::lock_guard<std::mutex> lock(ingestMutex);
+        
+        // Score against the history so far, then fold the charge in
+        auto score = [&](RunningStats& stats, const std::string& group) {
+            if (!flagged && stats.count >= anomalyMinSamples) {
+                // Fixed-price groups have ~0 variance; require at least a 10% deviation per sigma
+                double sd = std::max(stats.stddev(), 0.1 * stats.mean);
+                double z = sd > 0 ? (charge - stats.mean) / sd : 0.0;
+                if (z > anomalySigmas) {
+                    std::ostringstream message;
+                    message << std::fixed << std::setprecision(2) << "Unusual " << group
+                            << " charge: " << currencySymbol << charge << " vs typical "
+                            << currencySymbol << stats.mean << " ("
+                            << std::setprecision(1) << z << " sigma) - "
+                            << transaction.description;
+                    alert.type = Alert::WARNING;
+                    alert.message = message.str();
+                    alert.category = transaction.category;
+                    alert.amount = charge;
+                    alert.limit = stats.mean + anomalySigmas * sd;
+                    flagged = true;
+                }
+            }
+            stats.add(charge);
+        };
+        
+        score(categoryStats[transaction.category], transaction.category);
+        if (!merchant.empty()) {
+            score(merchantStats[merchant], merchant);
+        }
+        
+        if (flagged) {
+            ingestAlerts.push_back(alert);
+            callback = alertCallback;
+        }
+    }
+    
+    // Outside the lock so a callback may query the alert system
+    if (flagged && callback) {
+        callback(alert);
+    }
+    return flagged;
+}
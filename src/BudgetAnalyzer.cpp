@@ -18,50 +18,137 @@
 //BudgetAnalyzer.cpp
 
 #include "BudgetAnalyzer.h"
+#include "Hashing.h"
+#include "HyperLogLog.h"
+#include "MerchantNormalizer.h"
+#include "Parallel.h"
+#include "QuantileSketch.h"
 #include <algorithm>
+#include <cmath>
 #include <numeric>
+#include <unordered_map>
 
-BudgetAnalyzer::BudgetAnalyzer(const TransactionData& data) : transactionData(data) {}
+struct MerchantSketches {
+    SpaceSaving bySpend;
+    SpaceSaving byCount;
+};
 
-BudgetSummary BudgetAnalyzer::analyzeBudget() const {
-    BudgetSummary summary;
-    
-    const auto& transactions = transactionData.getAllTransactions();
-    
-    summary.totalIncome = 0.0;
-    summary.totalExpenses = 0.0;
+namespace {
+
+// Counters kept per merchant summary; any merchant above 1/1024 of the total is reported
+const size_t kMerchantCounters = 1024;
+const size_t kForecastHorizon = 24;
+
+// Rows per parallel chunk when sketching; below this a single pass is cheaper
+const size_t kParallelChunk = 1 << 16;
+
+struct SizeSketches {
+    QuantileSketch overall;
+    std::unordered_map<std::string, QuantileSketch> byCategory;
+    std::unordered_map<std::string, QuantileSketch> byAccount;
+    std::unordered_map<std::string, QuantileSketch> byMonth;
     
-    for (const auto& transaction : transactions) {
-        if (transaction.amount > 0) {
-            summary.totalIncome += transaction.amount;
-        } else {
-            summary.totalExpenses += std::abs(transaction.amount);
-        }
+    void merge(const SizeSketches& other) {
+        overall.merge(other.overall);
+        for (const auto& entry : other.byCategory) byCategory[entry.first].merge(entry.second);
+        for (const auto& entry : other.byAccount) byAccount[entry.first].merge(entry.second);
+        for (const auto& entry : other.byMonth) byMonth[entry.first].merge(entry.second);
     }
+};
+
+SizeDistribution summarize(const QuantileSketch& sketch) {
+    return {sketch.count(), sketch.quantile(0.5), sketch.quantile(0.9), sketch.quantile(0.99)};
+}
+
+struct DistinctSketches {
+    HyperLogLog overall;
+    std::unordered_map<std::string, HyperLogLog> byMonth;
+    std::unordered_map<std::string, HyperLogLog> byCategory;
+    std::unordered_map<std::string, HyperLogLog> byAccount;
     
-    summary.netChange = summary.totalIncome - summary.totalExpenses;
-    
-    // Category breakdown
-    summary.categoryBreakdown = transactionData.getCategoryTotals();
-    
-    // Account breakdown
-    for (const auto& account : transactionData.getUniqueAccounts()) {
-        auto accountTrans = transactionData.getTransactionsByAccount(account);
-        double accountTotal = 0.0;
-        for (const auto& t : accountTrans) {
-            accountTotal += (t.amount < 0 ? t.amount : 0);
-        }
-        summary.accountBreakdown[account] = accountTotal;
+    void merge(const DistinctSketches& other) {
+        overall.merge(other.overall);
+        for (const auto& entry : other.byMonth) byMonth[entry.first].merge(entry.second);
+        for (const auto& entry : other.byCategory) byCategory[entry.first].merge(entry.second);
+        for (const auto& entry : other.byAccount) byAccount[entry.first].merge(entry.second);
     }
-    
-    // Monthly trends
-    summary.monthlyTrends = transactionData.getMonthlyTotals();
-    
-    return summary;
+};
+
+std::map<std::string, double>
+estimate(const std::unordered_map<std::string, HyperLogLog>& counters) {
+    std::map<std::string, double> result;
+    for (const auto& entry : counters) {
+        result[entry.first] = entry.second.estimate();
+    }
+    return result;
+}
+
+std::map<std::string, SizeDistribution>
+summarize(const std::unordered_map<std::string, QuantileSketch>& sketches) {
+    std::map<std::string, SizeDistribution> result;
+    for (const auto& entry : sketches) {
+        result[entry.first] = summarize(entry.second);
+    }
+    return result;
+}
+
+} // namespace
+
+BudgetAnalyzer::BudgetAnalyzer(const TransactionData& data)
+    : transactionData(data), transferWindow(3), settingsVersion(0) {}
+
+template <typename T, typename Compute>
+T BudgetAnalyzer::cached(CachedResult<T>& slot, Compute compute) const {
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    uint64_t version = transactionData.getVersion();
+    uint64_t settings = settingsVersion.load();
+    if (!slot.valid || slot.version != version || slot.settings != settings) {
+        slot.value = compute();
+        slot.version = version;
+        slot.settings = settings;
+        slot.valid = true;
+    }
+    return slot.value;
+}
+
+BudgetSummary BudgetAnalyzer::analyzeBudget() const {
+    return cached(summaryCache, [this]() {
+        BudgetSummary summary;
+        
+        auto cube = getDataCube();
+        CubeCell total = cube->total();
+        summary.totalIncome = total.income;
+        summary.totalExpenses = std::abs(total.spending);
+        
+        // Account breakdown
+        const auto& accounts = cube->labels(CubeAxis::Account);
+        std::vector<CubeCell> byAccount = cube->rollUp(CubeAxis::Account);
+        for (size_t a = 0; a < accounts.size(); ++a) {
+            summary.accountBreakdown[accounts[a]] = byAccount[a].spending;
+        }
+        
+        std::vector<TransferMatch> transfers = getTransfers();
+        summary.matchedTransfers = transfers.size();
+        summary.transferVolume = 0.0;
+        for (const auto& transfer : transfers) {
+            summary.transferVolume += transactionData.getAllTransactions()[transfer.inflow].amount;
+        }
+        
+        summary.netChange = summary.totalIncome - summary.totalExpenses;
+        summary.distinctMerchants = getDistinctMerchants().overall;
+        
+        // Category breakdown
+        summary.categoryBreakdown = getCategoryAnalysis();
+        
+        // Monthly trends
+        summary.monthlyTrends = getMonthlyTrends();
+        
+        return summary;
+    });
 }
 
 std::map<std::string, double> BudgetAnalyzer::getTopSpendingCategories(int limit) const {
-    auto categoryTotals = transactionData.getCategoryTotals();
+    auto categoryTotals = getCategoryAnalysis();
     
     std::vector<std::pair<std::string, double>> sorted(categoryTotals.begin(), categoryTotals.end());
     std::sort(sorted.begin(), sorted.end(),
@@ -76,49 +163,270 @@ std::map<std::string, double> BudgetAnalyzer::getTopSpendingCategories(int limit
 }
 
 std::map<std::string, double> BudgetAnalyzer::getMonthlyTrends() const {
-    return transactionData.getMonthlyTotals();
+    return cached(monthlyCache, [this]() {
+        auto cube = getDataCube();
+        const auto& months = cube->labels(CubeAxis::Period);
+        std::vector<CubeCell> byMonth = cube->rollUp(CubeAxis::Period);
+        std::map<std::string, double> result;
+        for (size_t p = 0; p < months.size(); ++p) {
+            if (byMonth[p].count > 0) {
+                result[months[p]] = byMonth[p].spending;
+            }
+        }
+        return result;
+    });
 }
 
 std::map<std::string, double> BudgetAnalyzer::getCategoryAnalysis() const {
-    return transactionData.getCategoryTotals();
+    return cached(categoryCache, [this]() {
+        auto cube = getDataCube();
+        const auto& categories = cube->labels(CubeAxis::Category);
+        std::vector<CubeCell> byCategory = cube->rollUp(CubeAxis::Category);
+        std::map<std::string, double> result;
+        for (size_t c = 0; c < categories.size(); ++c) {
+            result[categories[c]] = byCategory[c].spending;
+        }
+        return result;
+    });
 }
 
 double BudgetAnalyzer::getSpendingTrend() const {
-    auto monthlyTrends = transactionData.getMonthlyTotals();
-    
-    if (monthlyTrends.size() < 2) return 0.0;
-    
-    auto it = monthlyTrends.rbegin();
-    double lastMonth = it->second;
-    ++it;
-    double prevMonth = it->second;
-    
-    if (prevMonth == 0) return 0.0;
-    return ((lastMonth - prevMonth) / std::abs(prevMonth)) * 100;
+    return getMonthOverMonthChange();
 }
 
 double BudgetAnalyzer::getAverageMonthlySpending() const {
-    auto monthlyTrends = transactionData.getMonthlyTotals();
-    
-    if (monthlyTrends.empty()) return 0.0;
+    auto series = getTimeSeries(Granularity::Month);
     
-    double total = 0.0;
-    for (const auto& pair : monthlyTrends) {
-        total += std::abs(pair.second);
-    }
+    if (series->activePeriodCount() == 0) return 0.0;
     
-    return total / monthlyTrends.size();
+    return std::abs(series->rangeTotal(0, series->periodCount() - 1)) / series->activePeriodCount();
 }
 
 double BudgetAnalyzer::getAverageTransaction() const {
-    const auto& transactions = transactionData.getAllTransactions();
-    
-    if (transactions.empty()) return 0.0;
+    return cached(averageTransactionCache,
+                  [this]() { return transactionData.getAverageTransaction(); });
+}
+
+std::vector<AccountReconciliation> BudgetAnalyzer::getReconciliation() const {
+    return cached(reconciliationCache,
+                  [this]() { return Reconciler().reconcile(transactionData); });
+}
+
+std::vector<CashFlowProjection> BudgetAnalyzer::getCashFlowProjection(int days) const {
+    return Reconciler().projectCashFlow(getReconciliation(), getRecurringPayments(), days);
+}
+
+void BudgetAnalyzer::setTransferMatchWindow(int days) {
+    transferWindow = days;
+    settingsVersion++;
+}
+
+std::vector<TransferMatch> BudgetAnalyzer::getTransfers() const {
+    return cached(transferCache, [this]() {
+        if (transferWindow < 0) return std::vector<TransferMatch>();
+        return TransferMatcher(transferWindow).match(transactionData);
+    });
+}
+
+std::vector<bool> BudgetAnalyzer::getTransferMask() const {
+    return TransferMatcher::matchedRows(getTransfers(),
+                                        transactionData.getAllTransactions().size());
+}
+
+std::shared_ptr<const DataCube> BudgetAnalyzer::getDataCube() const {
+    // Like cached(), except that a cube stale only by a recategorization is patched with the
+    // moved rows instead of being rebuilt
+    std::lock_guard<std::mutex> lock(cubeCache.mutex);
+    uint64_t version = transactionData.getVersion();
+    uint64_t settings = settingsVersion.load();
+    if (cubeCache.valid && cubeCache.version == version && cubeCache.settings == settings) {
+        return cubeCache.value;
+    }
     
-    double total = 0.0;
-    for (const auto& t : transactions) {
-        total += std::abs(t.amount);
+    std::vector<bool> transfers = getTransferMask();
+    std::shared_ptr<const DataCube> cube;
+    std::vector<CategoryChange> changes;
+    if (cubeCache.valid && cubeCache.settings == settings &&
+        transactionData.getCategoryChanges(cubeCache.version, changes)) {
+        cube = cubeCache.value->withCategoryChanges(transactionData, changes, transfers);
     }
+    if (!cube) cube = std::make_shared<const DataCube>(transactionData, transfers);
     
-    return total / transactions.size();
+    cubeCache.value = cube;
+    cubeCache.version = version;
+    cubeCache.settings = settings;
+    cubeCache.valid = true;
+    return cube;
+}
+
+std::shared_ptr<const CategoryTree> BudgetAnalyzer::getCategoryTree() const {
+    return cached(categoryTreeCache,
+                  [this]() { return std::make_shared<const CategoryTree>(*getDataCube()); });
+}
+
+double BudgetAnalyzer::getCategoryTotal(const std::string& path) const {
+    auto tree = getCategoryTree();
+    size_t node = tree->find(path);
+    return node == CategoryTree::npos ? 0.0 : tree->getNodes()[node].total.spending;
+}
+
+std::shared_ptr<const SpendingTimeSeries>
+BudgetAnalyzer::getTimeSeries(Granularity granularity) const {
+    auto& slot = timeSeriesCache[static_cast<int>(granularity)];
+    return cached(slot, [this, granularity]() {
+        return std::make_shared<const SpendingTimeSeries>(transactionData, granularity,
+                                                          getTransferMask());
+    });
+}
+
+double BudgetAnalyzer::getRollingSpending(size_t months, const std::string& category) const {
+    auto series = getTimeSeries(Granularity::Month);
+    if (series->periodCount() == 0) return 0.0;
+    return series->rollingSum(series->periodCount() - 1, months, category);
+}
+
+double BudgetAnalyzer::getRollingAverageSpending(size_t months, const std::string& category) const {
+    auto series = getTimeSeries(Granularity::Month);
+    if (series->periodCount() == 0) return 0.0;
+    return series->rollingAverage(series->periodCount() - 1, months, category);
+}
+
+double BudgetAnalyzer::getMonthOverMonthChange(const std::string& category) const {
+    auto series = getTimeSeries(Granularity::Month);
+    if (series->periodCount() == 0) return 0.0;
+    return series->periodOverPeriod(series->periodCount() - 1, 1, category);
+}
+
+double BudgetAnalyzer::getYearOverYearChange(const std::string& category) const {
+    auto series = getTimeSeries(Granularity::Month);
+    if (series->periodCount() == 0) return 0.0;
+    return series->yearOverYear(series->periodCount() - 1, category);
+}
+
+SizeDistributions BudgetAnalyzer::getSizeDistributions() const {
+    return cached(sizeDistributionCache, [this]() {
+        const auto& transactions = transactionData.getAllTransactions();
+        std::vector<bool> transfers = getTransferMask();
+        
+        // Sketch each chunk independently, then merge; sketches are order-insensitive
+        auto ranges = mt::partition(transactions.size(), kParallelChunk);
+        std::vector<SizeSketches> partial(ranges.size());
+        mt::parallelInvoke(ranges.size(), [&](size_t c) {
+            auto& sketches = partial[c];
+            for (size_t i = ranges[c].first; i < ranges[c].second; ++i) {
+                const auto& t = transactions[i];
+                if (t.amount == 0 || transfers[i]) continue;
+                double size = std::abs(t.amount);
+                sketches.overall.add(size);
+                sketches.byCategory[t.category].add(size);
+                sketches.byAccount[t.accountName].add(size);
+                sketches.byMonth[t.date.substr(0, 7)].add(size);
+            }
+        });
+        for (size_t c = 1; c < partial.size(); ++c) {
+            partial[0].merge(partial[c]);
+        }
+        
+        SizeDistributions result;
+        result.overall = summarize(partial[0].overall);
+        result.byCategory = summarize(partial[0].byCategory);
+        result.byAccount = summarize(partial[0].byAccount);
+        result.byMonth = summarize(partial[0].byMonth);
+        return result;
+    });
+}
+
+std::map<std::string, SizeDistribution> BudgetAnalyzer::getCategorySizeDistribution() const {
+    return getSizeDistributions().byCategory;
+}
+
+std::map<std::string, SizeDistribution> BudgetAnalyzer::getAccountSizeDistribution() const {
+    return getSizeDistributions().byAccount;
+}
+
+std::map<std::string, SizeDistribution> BudgetAnalyzer::getMonthlySizeDistribution() const {
+    return getSizeDistributions().byMonth;
+}
+
+MerchantReport BudgetAnalyzer::getTopMerchants(size_t limit) const {
+    auto sketches = cached(merchantCache, [this]() {
+        const auto& transactions = transactionData.getAllTransactions();
+        std::vector<bool> transfers = getTransferMask();
+        
+        // Chunks are summarized independently and merged, as parallel parse batches would be
+        auto ranges = mt::partition(transactions.size(), kParallelChunk);
+        std::vector<MerchantSketches> partial(
+            ranges.size(), {SpaceSaving(kMerchantCounters), SpaceSaving(kMerchantCounters)});
+        mt::parallelInvoke(ranges.size(), [&](size_t c) {
+            for (size_t i = ranges[c].first; i < ranges[c].second; ++i) {
+                const auto& t = transactions[i];
+                if (t.amount >= 0 || transfers[i]) continue;
+                const std::string& merchant = merchantKey(t);
+                if (merchant.empty()) continue;
+                partial[c].bySpend.add(merchant, std::abs(t.amount));
+                partial[c].byCount.add(merchant);
+            }
+        });
+        for (size_t c = 1; c < partial.size(); ++c) {
+            partial[0].bySpend.merge(partial[c].bySpend);
+            partial[0].byCount.merge(partial[c].byCount);
+        }
+        return std::make_shared<const MerchantSketches>(std::move(partial[0]));
+    });
+    
+    return {sketches->bySpend.top(limit), sketches->byCount.top(limit)};
+}
+
+DistinctCounts BudgetAnalyzer::getDistinctMerchants() const {
+    return cached(distinctCache, [this]() {
+        const auto& transactions = transactionData.getAllTransactions();
+        std::vector<bool> transfers = getTransferMask();
+        
+        auto ranges = mt::partition(transactions.size(), kParallelChunk);
+        std::vector<DistinctSketches> partial(ranges.size());
+        mt::parallelInvoke(ranges.size(), [&](size_t c) {
+            auto& sketches = partial[c];
+            for (size_t i = ranges[c].first; i < ranges[c].second; ++i) {
+                const auto& t = transactions[i];
+                if (transfers[i]) continue;
+                const std::string& merchant = merchantKey(t);
+                if (merchant.empty()) continue;
+                // Hash once; every group's register update reuses it
+                uint64_t hash = mt::hashBytes(merchant);
+                sketches.overall.addHash(hash);
+                sketches.byMonth[t.date.substr(0, 7)].addHash(hash);
+                sketches.byCategory[t.category].addHash(hash);
+                sketches.byAccount[t.accountName].addHash(hash);
+            }
+        });
+        for (size_t c = 1; c < partial.size(); ++c) {
+            partial[0].merge(partial[c]);
+        }
+        
+        DistinctCounts result;
+        result.overall = partial[0].overall.estimate();
+        result.byMonth = estimate(partial[0].byMonth);
+        result.byCategory = estimate(partial[0].byCategory);
+        result.byAccount = estimate(partial[0].byAccount);
+        return result;
+    });
+}
+
+std::vector<RecurringSeries> BudgetAnalyzer::getRecurringPayments() const {
+    return cached(recurringCache, [this]() {
+        return RecurringDetector().detect(transactionData, getTransferMask());
+    });
+}
+
+ForecastResult BudgetAnalyzer::getSpendingForecast(size_t months) const {
+    // Fit once for the longest horizon and hand out prefixes of it
+    ForecastResult result = cached(forecastCache, [this]() {
+        return SpendingForecaster(kForecastHorizon).forecast(*getDataCube());
+    });
+    months = std::min(months, kForecastHorizon);
+    result.months.resize(std::min(months, result.months.size()));
+    for (auto& group : result.groups) {
+        group.values.resize(months);
+    }
+    return result;
 }
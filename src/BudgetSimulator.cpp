@@ -0,0 +1,133 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "BudgetSimulator.h"
+#include "CategoryTree.h"
+#include "Hashing.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Scenarios per RNG stream / pool task, and per inner vector block
+const size_t kScenariosPerTask = 4096;
+const size_t kBlock = 256;
+
+// splitmix64: one 64-bit add and a mix per draw, and trivially split into streams
+struct RandomStream {
+    uint64_t state;
+    
+    uint64_t next() {
+        state += 0x9e3779b97f4a7c15ULL;
+        return mt::mixHash(state);
+    }
+    
+    // Uniform index in [0, bound) by multiply-shift
+    static uint32_t bounded(uint64_t random, uint32_t bound) {
+        return static_cast<uint32_t>(((random >> 32) * bound) >> 32);
+    }
+};
+
+bool coversCategory(const std::string& limitPath, const std::string& category) {
+    std::string path = CategoryTree::normalizePath(category);
+    return path == limitPath || (path.size() > limitPath.size() &&
+                                 path.compare(0, limitPath.size(), limitPath) == 0 &&
+                                 path[limitPath.size()] == CategoryTree::kSeparator);
+}
+
+double percentile(std::vector<double>& values, double q) {
+    if (values.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(std::ceil(q * values.size()));
+    rank = std::min(values.size() - 1, rank == 0 ? 0 : rank - 1);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+} // namespace
+
+BudgetSimulator::BudgetSimulator(size_t scenarios, size_t historyMonths, uint64_t seed)
+    : scenarios(scenarios), historyMonths(std::max<size_t>(1, historyMonths)), seed(seed) {}
+
+SimulationResult BudgetSimulator::run(const DataCube& cube, const AlertSystem& alerts) const {
+    SimulationResult result;
+    result.scenarios = scenarios;
+    
+    // History: categories x months of positive spending over the trailing window
+    const auto& categories = cube.labels(CubeAxis::Category);
+    size_t periods = cube.size(CubeAxis::Period);
+    size_t months = std::min(historyMonths, periods);
+    result.historyMonths = months;
+    
+    std::vector<double> history(categories.size() * months, 0.0);
+    for (size_t c = 0; c < categories.size(); ++c) {
+        for (size_t a = 0; a < cube.size(CubeAxis::Account); ++a) {
+            const CubeCell* run = cube.series(c, a);
+            for (size_t m = 0; m < months; ++m) {
+                history[c * months + m] -= run[periods - months + m].spending;
+            }
+        }
+    }
+    
+    // Limits: the overall limit first, then each category limit with the columns it covers
+    result.outlooks.push_back({"Overall", alerts.getOverallLimit(), 0, 0, 0, 0, 0});
+    std::vector<std::vector<size_t>> members(1);
+    for (size_t c = 0; c < categories.size(); ++c) members[0].push_back(c);
+    for (const auto& limit : alerts.getCategoryLimits()) {
+        std::string path = CategoryTree::normalizePath(limit.first);
+        result.outlooks.push_back({limit.first, limit.second, 0, 0, 0, 0, 0});
+        members.emplace_back();
+        for (size_t c = 0; c < categories.size(); ++c) {
+            if (coversCategory(path, categories[c])) members.back().push_back(c);
+        }
+    }
+    if (scenarios == 0 || months == 0) return result;
+    
+    // For every category, the limits whose totals it feeds
+    std::vector<std::vector<size_t>> feeds(categories.size());
+    for (size_t l = 0; l < members.size(); ++l) {
+        for (size_t c : members[l]) feeds[c].push_back(l);
+    }
+    
+    // Simulated monthly totals, one contiguous row of scenarios per limit
+    std::vector<double> totals(members.size() * scenarios, 0.0);
+    size_t tasks = (scenarios + kScenariosPerTask - 1) / kScenariosPerTask;
+    uint32_t bound = static_cast<uint32_t>(months);
+    
+    mt::parallelInvoke(tasks, [&](size_t task) {
+        RandomStream rng{mt::combineHash(seed, task)};
+        size_t taskEnd = std::min(scenarios, (task + 1) * kScenariosPerTask);
+        double draws[kBlock];
+        
+        for (size_t begin = task * kScenariosPerTask; begin < taskEnd; begin += kBlock) {
+            size_t count = std::min(kBlock, taskEnd - begin);
+            for (size_t c = 0; c < categories.size(); ++c) {
+                if (feeds[c].empty()) continue;
+                const double* column = &history[c * months];
+                for (size_t s = 0; s < count; ++s) {
+                    draws[s] = column[RandomStream::bounded(rng.next(), bound)];
+                }
+                for (size_t l : feeds[c]) {
+                    double* target = &totals[l * scenarios + begin];
+                    for (size_t s = 0; s < count; ++s) target[s] += draws[s];
+                }
+            }
+        }
+    });
+    
+    for (size_t l = 0; l < members.size(); ++l) {
+        LimitOutlook& outlook = result.outlooks[l];
+        std::vector<double> row(totals.begin() + l * scenarios,
+                                totals.begin() + (l + 1) * scenarios);
+        if (outlook.limit > 0) {
+            size_t exceeded = std::count_if(row.begin(), row.end(),
+                                            [&outlook](double v) { return v > outlook.limit; });
+            outlook.exceedanceProbability = static_cast<double>(exceeded) / scenarios;
+        }
+        outlook.median = percentile(row, 0.5);
+        outlook.p90 = percentile(row, 0.9);
+        outlook.p95 = percentile(row, 0.95);
+        outlook.p99 = percentile(row, 0.99);
+    }
+    return result;
+}
@@ -19,6 +19,7 @@
 
 #include "CSVParser.h"
 #include "DateParser.h"
+#include "MerchantNormalizer.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
@@ -63,9 +64,13 @@ std::string CSVParser::trim(const std::string& str) {
 
 double CSVParser::parseAmount(const std::string& amount) {
     std::string cleaned = amount;
-    // Remove commas and dollar signs
-    cleaned.erase(std::remove(cleaned.begin(), cleaned.end(), ','), cleaned.end());
-    cleaned.erase(std::remove(cleaned.begin(), cleaned.end(), '$'), cleaned.end());
+    // Remove commas and currency symbols ($, and the UTF-8 encodings of €, £ and ¥)
+    for (const char* symbol : {",", "$", "\xE2\x82\xAC", "\xC2\xA3", "\xC2\xA5"}) {
+        for (size_t pos = cleaned.find(symbol); pos != std::string::npos;
+             pos = cleaned.find(symbol, pos)) {
+            cleaned.erase(pos, std::char_traits<char>::length(symbol));
+        }
+    }
     cleaned = trim(cleaned);
     
     try {
@@ -75,12 +80,23 @@ double CSVParser::parseAmount(const std::string& amount) {
     }
 }
 
-std::string CSVParser::categorizeTransaction(const std::string& description) {
-    if (config) {
-        return config->categorizeTransaction(description);
+void CSVParser::categorize(std::vector<Transaction>& transactions) {
+    std::vector<CategorizationInput> inputs(transactions.size());
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        Transaction& t = transactions[i];
+        t.merchant = &internMerchant(normalizeMerchant(t.description));
+        inputs[i].description = t.description;
+        inputs[i].amount = t.statementAmount();
+        inputs[i].account = t.accountName;
+        inputs[i].date = t.date;
+        inputs[i].merchant = t.merchant;
     }
     
-    return "Other";
+    std::vector<CategoryId> ids = config->categorizeBatch(inputs);
+    std::vector<std::string> names = config->getCategoryNames();
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        transactions[i].category = names[ids[i]];
+    }
 }
 
 std::vector<Transaction> CSVParser::parseBank(const std::string& filePath, const std::string& accountName) {
@@ -130,9 +146,8 @@ std::vector<Transaction> CSVParser::parseBank(const std::string& filePath, const
             transaction.amount = (debit > 0) ? -debit : credit;
             
             transaction.balance = parseAmount(parts[4]);
-            transaction.category = categorizeTransaction(transaction.description);
+            transaction.hasBalance = !trim(parts[4]).empty();
             transaction.accountName = accountName;
-            
             transactions.push_back(transaction);
         } catch (const std::exception& e) {
             parseErrors++;
@@ -141,6 +156,7 @@ std::vector<Transaction> CSVParser::parseBank(const std::string& filePath, const
     }
     
     file.close();
+    categorize(transactions);
     
     if (parseErrors > 0) {
         throw std::runtime_error(std::to_string(parseErrors) + " lines failed to parse in " + filePath);
@@ -217,11 +233,10 @@ std::vector<Transaction> CSVParser::parseGeneric(const std::string& filePath, co
             // Get balance if available (usually last column)
             if (parts.size() >= 4) {
                 transaction.balance = parseAmount(parts[parts.size() - 1]);
+                transaction.hasBalance = !trim(parts[parts.size() - 1]).empty();
             }
             
-            transaction.category = categorizeTransaction(transaction.description);
             transaction.accountName = accountName;
-            
             transactions.push_back(transaction);
         } catch (const std::exception& e) {
             parseErrors++;
@@ -230,6 +245,7 @@ std::vector<Transaction> CSVParser::parseGeneric(const std::string& filePath, co
     }
     
     file.close();
+    categorize(transactions);
     
     if (parseErrors > 0) {
         throw std::runtime_error(std::to_string(parseErrors) + " lines failed to parse in " + filePath);
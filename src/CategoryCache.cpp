@@ -0,0 +1,58 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "CategoryCache.h"
+#include "Hashing.h"
+#include <algorithm>
+
+CategoryCache::CategoryCache(size_t capacity)
+    : shardCapacity(std::max<size_t>(1, (capacity + kShards - 1) / kShards)), hits(0), misses(0) {
+}
+
+CategoryCache::Shard& CategoryCache::shardFor(const std::string& key) const {
+    // The maps inside a shard bucket on std::hash, so an independent hash picks the shard
+    return shards[mt::hashBytes(key) % kShards];
+}
+
+bool CategoryCache::lookup(const std::string& key, CategoryId& id) const {
+    Shard& shard = shardFor(key);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            id = it->second;
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void CategoryCache::insert(const std::string& key, CategoryId id) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.entries.size() >= shardCapacity && !shard.entries.count(key)) {
+        shard.entries.clear();
+    }
+    shard.entries[key] = id;
+}
+
+void CategoryCache::clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries.clear();
+    }
+    hits.store(0, std::memory_order_relaxed);
+    misses.store(0, std::memory_order_relaxed);
+}
+
+CategoryCacheStats CategoryCache::stats() const {
+    CategoryCacheStats result{hits.load(std::memory_order_relaxed),
+                              misses.load(std::memory_order_relaxed), 0};
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        result.entries += shard.entries.size();
+    }
+    return result;
+}
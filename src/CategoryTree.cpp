@@ -0,0 +1,98 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "CategoryTree.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+std::string trim(const std::string& text, size_t begin, size_t end) {
+    while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) ++begin;
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) --end;
+    return text.substr(begin, end - begin);
+}
+
+} // namespace
+
+CategoryTree::CategoryTree(const DataCube& cube) {
+    const auto& categories = cube.labels(CubeAxis::Category);
+    std::vector<CubeCell> leaves = cube.rollUp(CubeAxis::Category);
+    
+    for (size_t c = 0; c < categories.size(); ++c) {
+        std::string path = normalizePath(categories[c]);
+        if (path.empty()) path = "Other";
+        nodes[intern(path)].direct.add(leaves[c]);
+    }
+    
+    // Children always follow their parent in `nodes`, so walking backwards is post-order
+    for (size_t i = nodes.size(); i-- > 0;) {
+        nodes[i].total.add(nodes[i].direct);
+        if (nodes[i].parent != npos) nodes[nodes[i].parent].total.add(nodes[i].total);
+    }
+    
+    auto byName = [this](size_t a, size_t b) { return nodes[a].name < nodes[b].name; };
+    for (auto& node : nodes) {
+        std::sort(node.children.begin(), node.children.end(), byName);
+    }
+    std::sort(roots.begin(), roots.end(), byName);
+}
+
+size_t CategoryTree::intern(const std::string& path) {
+    auto it = pathIndex.find(path);
+    if (it != pathIndex.end()) return it->second;
+    
+    size_t split = path.rfind(kSeparator);
+    size_t parent = split == std::string::npos ? npos : intern(path.substr(0, split));
+    
+    CategoryNode node;
+    node.name = split == std::string::npos ? path : path.substr(split + 1);
+    node.path = path;
+    node.parent = parent;
+    node.depth = parent == npos ? 0 : nodes[parent].depth + 1;
+    
+    size_t id = nodes.size();
+    nodes.push_back(std::move(node));
+    pathIndex.emplace(path, id);
+    if (parent == npos) {
+        roots.push_back(id);
+    } else {
+        nodes[parent].children.push_back(id);
+    }
+    return id;
+}
+
+size_t CategoryTree::find(const std::string& path) const {
+    auto it = pathIndex.find(normalizePath(path));
+    return it == pathIndex.end() ? npos : it->second;
+}
+
+std::vector<size_t> CategoryTree::preOrder() const {
+    std::vector<size_t> order;
+    order.reserve(nodes.size());
+    std::vector<size_t> stack(roots.rbegin(), roots.rend());
+    while (!stack.empty()) {
+        size_t id = stack.back();
+        stack.pop_back();
+        order.push_back(id);
+        const auto& children = nodes[id].children;
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+    return order;
+}
+
+std::string CategoryTree::normalizePath(const std::string& category) {
+    std::string result;
+    size_t begin = 0;
+    while (begin <= category.size()) {
+        size_t end = category.find(kSeparator, begin);
+        if (end == std::string::npos) end = category.size();
+        std::string segment = trim(category, begin, end);
+        if (!segment.empty()) {
+            if (!result.empty()) result += kSeparator;
+            result += segment;
+        }
+        begin = end + 1;
+    }
+    return result;
+}
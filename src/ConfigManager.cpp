@@ -2,138 +2,652 @@
 //MIT License
 
 #include "ConfigManager.h"
+#include "Hashing.h"
+#include "JsonReader.h"
+#include "MerchantNormalizer.h"
+#include "Parallel.h"
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <set>
 #include <sstream>
 #include <iostream>
+#include <stdexcept>
+#include <cerrno>
+#include <unistd.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
 
-ConfigManager::ConfigManager() {
+ConfigManager::ConfigManager() : stopPipe{-1, -1} {
     loadDefaultCategories();
 }
 
+ConfigManager::~ConfigManager() {
+    stopWatching();
+}
+
 bool ConfigManager::loadCategoriesFromFile(const std::string& filePath) {
-    // Simple JSON parsing - for production would use a proper JSON library
-    std::ifstream file(filePath);
+    std::string error;
+    if (!loadRuleSet(filePath, error)) {
+        std::cerr << "Warning: " << error << std::endl;
+        return false;
+    }
+    return !snapshot()->rules.empty();
+}
+
+bool ConfigManager::loadRuleSet(const std::string& filePath, std::string& error) {
+    std::ifstream file(filePath, std::ios::binary);
     if (!file.is_open()) {
-        std::cerr << "Warning: Could not load categories from " << filePath << ", using defaults" << std::endl;
+        error = "Could not load categories from " + filePath + ", keeping current categories";
         return false;
     }
+    std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
     
-    categories.clear();
-    std::string line;
-    std::string currentCategory;
+    uint64_t sourceHash = mt::hashBytes(source);
+    std::string cachePath = filePath + kRuleCacheSuffix;
+    if (auto cached = loadRuleCache(cachePath, sourceHash)) {
+        publish(std::move(cached));
+        return true;
+    }
     
-    while (std::getline(file, line)) {
-        // Very basic JSON parsing - look for category names
-        if (line.find("\"category\"") != std::string::npos) {
-            size_t start = line.find("\"category\": \"");
-            if (start != std::string::npos) {
-                start += 13;  // len("\"category\": \"")
-                size_t end = line.find("\"", start);
-                currentCategory = line.substr(start, end - start);
+    auto set = std::make_shared<RuleSet>();
+    try {
+        CategoryConfig parsed = parseCategories(source);
+        set->program.compile(parsed.rules);
+        set->rules = std::move(parsed.rules);
+        set->overrides = std::move(parsed.overrides);
+    } catch (const std::exception& e) {
+        error = "Could not load " + filePath + " (" + e.what() + "), keeping current categories";
+        return false;
+    }
+    
+    saveRuleCache(*set, cachePath, sourceHash);
+    publish(std::move(set));
+    return true;
+}
+
+void ConfigManager::publish(std::shared_ptr<RuleSet> next) {
+    std::lock_guard<std::mutex> lock(publishMutex);
+    std::shared_ptr<const RuleSet> previous = snapshot();
+    
+    // Keep every id handed out so far; only new category names get new ids
+    if (previous) {
+        next->categoryNames = previous->categoryNames;
+        next->version = previous->version + 1;
+    } else {
+        next->categoryNames.assign(1, "Other");
+        next->version = 1;
+    }
+    std::unordered_map<std::string, CategoryId> ids;
+    for (CategoryId id = 0; id < next->categoryNames.size(); ++id) {
+        ids.emplace(next->categoryNames[id], id);
+    }
+    auto idOf = [&](const std::string& name) {
+        auto inserted = ids.emplace(name, static_cast<CategoryId>(next->categoryNames.size()));
+        if (inserted.second) next->categoryNames.push_back(name);
+        return inserted.first->second;
+    };
+    next->ruleCategory.clear();
+    for (const auto& rule : next->rules) {
+        next->ruleCategory.push_back(idOf(rule.category));
+    }
+    // The first override listed for a merchant wins
+    next->overrideIds.clear();
+    for (const auto& entry : next->overrides) {
+        next->overrideIds.emplace(entry.first, idOf(entry.second));
+    }
+    
+    std::atomic_store(&current, std::shared_ptr<const RuleSet>(std::move(next)));
+}
+
+void ConfigManager::setReloadCallback(ReloadCallback callback) {
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    reloadCallback = std::move(callback);
+}
+
+bool ConfigManager::watchCategoriesFile(const std::string& filePath) {
+    stopWatching();
+#ifdef __linux__
+    size_t slash = filePath.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "."
+                          : filePath.substr(0, std::max<size_t>(slash, 1));
+    std::string fileName = filePath.substr(slash == std::string::npos ? 0 : slash + 1);
+    if (fileName.empty()) return false;
+    
+    int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) return false;
+    // Editors either rewrite the file in place or rename a new one over it
+    if (::inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0 ||
+        ::pipe(stopPipe) != 0) {
+        ::close(fd);
+        stopPipe[0] = stopPipe[1] = -1;
+        return false;
+    }
+    watcher = std::thread(&ConfigManager::watchLoop, this, fd, filePath, fileName);
+    return true;
+#else
+    (void)filePath;
+    return false;
+#endif
+}
+
+void ConfigManager::stopWatching() {
+    if (!watcher.joinable()) return;
+    // Closing the write end alone would also wake the loop; the byte makes it explicit
+    char stop = 1;
+    ssize_t written = ::write(stopPipe[1], &stop, 1);
+    (void)written;
+    ::close(stopPipe[1]);
+    watcher.join();
+    ::close(stopPipe[0]);
+    stopPipe[0] = stopPipe[1] = -1;
+}
+
+void ConfigManager::watchLoop(int inotifyFd, std::string filePath, std::string fileName) {
+#ifdef __linux__
+    pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {stopPipe[0], POLLIN, 0}};
+    bool pending = false;
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        // Wait for changes to settle (a save is often several events) before reloading
+        int ready = ::poll(fds, 2, pending ? kReloadDebounceMs : -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents != 0) break;
+        if (ready == 0) {
+            pending = false;
+            std::string message;
+            CategoryConfig previous = getConfig();
+            bool loaded = loadRuleSet(filePath, message);
+            if (loaded) message = "Reloaded categories from " + filePath;
+            std::lock_guard<std::mutex> lock(callbackMutex);
+            if (reloadCallback) reloadCallback(loaded, message, previous);
+            continue;
+        }
+        ssize_t length;
+        while ((length = ::read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+                if (event->len > 0 && fileName == event->name) pending = true;
+                p += sizeof(inotify_event) + event->len;
             }
         }
-        // Look for keywords array
-        if (line.find("\"keywords\"") != std::string::npos && !currentCategory.empty()) {
-            std::vector<std::string> keywords;
-            // This is simplified - a real implementation would use a JSON parser
-            while (std::getline(file, line)) {
-                if (line.find("]") != std::string::npos) break;
-                size_t start = line.find("\"");
-                if (start != std::string::npos) {
-                    size_t end = line.find("\"", start + 1);
-                    if (end != std::string::npos) {
-                        keywords.push_back(line.substr(start + 1, end - start - 1));
+    }
+    ::close(inotifyFd);
+#else
+    (void)inotifyFd;
+    (void)filePath;
+    (void)fileName;
+#endif
+}
+
+CategoryConfig ConfigManager::parseCategories(std::string_view json) {
+    // {
+    //   "categories": [ { "category": "...", "keywords": ["...", ...],
+    //                     "pattern": "...", "minAmount": -500, "maxAmount": -0.01,
+    //                     "account": "...", "startDate": "YYYY-MM-DD", "endDate": "..." } ],
+    //   "overrides": { "merchant": "category", ... }
+    // }
+    // Unknown members are skipped so the file can carry extra settings.
+    CategoryConfig config;
+    JsonReader reader(json);
+    std::string_view key;
+    reader.beginObject();
+    while (reader.nextMember(key)) {
+        if (key == "overrides") {
+            reader.beginObject();
+            std::string_view merchant;
+            while (reader.nextMember(merchant)) {
+                std::string name = normalizeMerchant(merchant);
+                std::string category(reader.readString());
+                if (!name.empty() && !category.empty()) {
+                    config.overrides.emplace_back(std::move(name), std::move(category));
+                }
+            }
+            continue;
+        }
+        if (key != "categories") {
+            reader.skipValue();
+            continue;
+        }
+        reader.beginArray();
+        while (reader.nextElement()) {
+            CategoryRule rule;
+            reader.beginObject();
+            while (reader.nextMember(key)) {
+                if (key == "category") {
+                    rule.category = std::string(reader.readString());
+                } else if (key == "keywords") {
+                    reader.beginArray();
+                    while (reader.nextElement()) {
+                        rule.keywords.emplace_back(reader.readString());
                     }
+                } else if (key == "pattern") {
+                    rule.pattern = std::string(reader.readString());
+                } else if (key == "minAmount") {
+                    rule.minAmount = reader.readNumber();
+                } else if (key == "maxAmount") {
+                    rule.maxAmount = reader.readNumber();
+                } else if (key == "account") {
+                    rule.account = std::string(reader.readString());
+                } else if (key == "startDate") {
+                    rule.startDate = std::string(reader.readString());
+                } else if (key == "endDate") {
+                    rule.endDate = std::string(reader.readString());
+                } else {
+                    reader.skipValue();
                 }
             }
-            if (!keywords.empty()) {
-                addCategory(currentCategory, keywords);
+            if (!rule.category.empty() && rule.hasConditions()) {
+                config.rules.push_back(std::move(rule));
             }
         }
     }
+    if (reader.peek() != JsonReader::Type::End) {
+        throw std::runtime_error("trailing content after the top-level object");
+    }
+    return config;
+}
+
+// Rule cache layout, in native-endian 32-bit words (a foreign byte order fails the magic check):
+//   magic, format version, source hash (2 words), payload hash (2 words), then the payload:
+//   rule count; per rule the category, keyword count, keywords, pattern, min and max amount
+//   (2 words each), account, start and end date; override count and (merchant, category)
+//   pairs; finally the automaton as written by KeywordMatcher::serialize. Strings are a
+//   byte length followed by the bytes, padded to a word.
+namespace {
+
+const uint32_t kRuleCacheMagic = 0x4352544D;  // "MTRC"
+const uint32_t kRuleCacheVersion = 2;
+const size_t kRuleCacheHeader = 6;
+
+void putString(std::vector<uint32_t>& words, const std::string& s) {
+    words.push_back(static_cast<uint32_t>(s.size()));
+    size_t offset = words.size();
+    words.resize(offset + (s.size() + 3) / 4, 0);
+    std::memcpy(words.data() + offset, s.data(), s.size());
+}
+
+void putDouble(std::vector<uint32_t>& words, double value) {
+    uint32_t halves[2];
+    std::memcpy(halves, &value, sizeof(value));
+    words.insert(words.end(), halves, halves + 2);
+}
+
+void putHash(std::vector<uint32_t>& words, size_t at, uint64_t hash) {
+    words[at] = static_cast<uint32_t>(hash);
+    words[at + 1] = static_cast<uint32_t>(hash >> 32);
+}
+
+// Sequential reader over the mapped words; every read is bounds-checked
+struct WordReader {
+    const uint32_t* words;
+    size_t count;
+    size_t pos;
+    bool ok;
     
-    file.close();
-    return !categories.empty();
+    uint32_t word() {
+        if (pos >= count) {
+            ok = false;
+            return 0;
+        }
+        return words[pos++];
+    }
+    double number() {
+        uint32_t halves[2] = {word(), word()};
+        double value;
+        std::memcpy(&value, halves, sizeof(value));
+        return value;
+    }
+    std::string string() {
+        size_t length = word();
+        size_t padded = (length + 3) / 4;
+        if (!ok || padded > count - pos) {
+            ok = false;
+            return std::string();
+        }
+        std::string s(reinterpret_cast<const char*>(words + pos), length);
+        pos += padded;
+        return s;
+    }
+};
+
+uint64_t getHash(const uint32_t* words, size_t at) {
+    return (uint64_t(words[at + 1]) << 32) | words[at];
+}
+
+} // namespace
+
+std::shared_ptr<ConfigManager::RuleSet> ConfigManager::loadRuleCache(const std::string& cachePath,
+                                                                     uint64_t sourceHash) {
+    MappedFile mapping;
+    if (!mapping.open(cachePath) || mapping.size() % 4 != 0) return nullptr;
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(mapping.data());
+    size_t count = mapping.size() / 4;
+    if (count <= kRuleCacheHeader || words[0] != kRuleCacheMagic ||
+        words[1] != kRuleCacheVersion || getHash(words, 2) != sourceHash) {
+        return nullptr;
+    }
+    std::string_view payload(reinterpret_cast<const char*>(words + kRuleCacheHeader),
+                             (count - kRuleCacheHeader) * 4);
+    if (mt::hashBytes(payload) != getHash(words, 4)) return nullptr;
+    
+    WordReader in{words, count, kRuleCacheHeader, true};
+    std::vector<CategoryRule> rules(std::min<size_t>(in.word(), count));
+    for (auto& rule : rules) {
+        rule.category = in.string();
+        rule.keywords.resize(std::min<size_t>(in.word(), count));
+        for (auto& keyword : rule.keywords) keyword = in.string();
+        rule.pattern = in.string();
+        rule.minAmount = in.number();
+        rule.maxAmount = in.number();
+        rule.account = in.string();
+        rule.startDate = in.string();
+        rule.endDate = in.string();
+    }
+    std::vector<std::pair<std::string, std::string>> overrides(std::min<size_t>(in.word(), count));
+    for (auto& entry : overrides) {
+        entry.first = in.string();
+        entry.second = in.string();
+    }
+    if (!in.ok) return nullptr;
+    
+    auto set = std::make_shared<RuleSet>();
+    try {
+        if (!set->program.attach(rules, words + in.pos, count - in.pos)) return nullptr;
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+    set->rules = std::move(rules);
+    set->overrides = std::move(overrides);
+    set->mapping = std::move(mapping);
+    set->fromCache = true;
+    return set;
+}
+
+void ConfigManager::saveRuleCache(const RuleSet& set, const std::string& cachePath,
+                                  uint64_t sourceHash) {
+    std::vector<uint32_t> words = {kRuleCacheMagic, kRuleCacheVersion, 0, 0, 0, 0,
+                                   static_cast<uint32_t>(set.rules.size())};
+    putHash(words, 2, sourceHash);
+    for (const auto& rule : set.rules) {
+        putString(words, rule.category);
+        words.push_back(static_cast<uint32_t>(rule.keywords.size()));
+        for (const auto& keyword : rule.keywords) putString(words, keyword);
+        putString(words, rule.pattern);
+        putDouble(words, rule.minAmount);
+        putDouble(words, rule.maxAmount);
+        putString(words, rule.account);
+        putString(words, rule.startDate);
+        putString(words, rule.endDate);
+    }
+    words.push_back(static_cast<uint32_t>(set.overrides.size()));
+    for (const auto& entry : set.overrides) {
+        putString(words, entry.first);
+        putString(words, entry.second);
+    }
+    set.program.serialize(words);
+    putHash(words, 4, mt::hashBytes(std::string_view(
+        reinterpret_cast<const char*>(words.data() + kRuleCacheHeader),
+        (words.size() - kRuleCacheHeader) * 4)));
+    
+    // Write a private temporary file and rename it over the cache, so concurrent runs never
+    // map a half-written file. Failure (e.g. a read-only directory) just means no cache.
+    std::string tempPath = cachePath + ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+        out.write(reinterpret_cast<const char*>(words.data()),
+                  static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+        if (!out.good()) {
+            out.close();
+            std::remove(tempPath.c_str());
+            return;
+        }
+    }
+    if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+    }
 }
 
 std::string ConfigManager::categorizeTransaction(const std::string& description) const {
-    std::string desc = toLower(description);
+    return categoryName(categorize(description));
+}
+
+CategoryId ConfigManager::categorize(std::string_view description) const {
+    CategorizationInput input;
+    input.description = description;
+    return categorize(input);
+}
+
+CategoryId ConfigManager::categorize(const CategorizationInput& input) const {
+    return categorize(*snapshot(), input);
+}
+
+CategoryId ConfigManager::categorize(const RuleSet& set, const CategorizationInput& input) {
+    std::string key = cacheKey(set, input);
+    CategoryId id;
+    if (set.cache.lookup(key, id)) return id;
     
-    for (const auto& rule : categories) {
-        for (const auto& keyword : rule.keywords) {
-            if (desc.find(toLower(keyword)) != std::string::npos) {
-                return rule.category;
+    id = kOther;
+    bool overridden = false;
+    if (!set.overrideIds.empty()) {
+        auto it = set.overrideIds.find(input.merchant ? *input.merchant
+                                                      : normalizeMerchant(input.description));
+        if (it != set.overrideIds.end()) {
+            id = it->second;
+            overridden = true;
+        }
+    }
+    if (!overridden) {
+        uint32_t rule = set.program.evaluate(input);
+        if (rule != RuleProgram::npos) id = set.ruleCategory[rule];
+    }
+    set.cache.insert(key, id);
+    return id;
+}
+
+namespace {
+
+bool sameInput(const CategorizationInput& a, const CategorizationInput& b) {
+    return a.description == b.description && a.account == b.account && a.date == b.date &&
+           (a.amount == b.amount || (std::isnan(a.amount) && std::isnan(b.amount)));
+}
+
+} // namespace
+
+void ConfigManager::categorizeBatch(const CategorizationInput* inputs, CategoryId* ids,
+                                    size_t count) const {
+    std::shared_ptr<const RuleSet> set = snapshot();
+    auto run = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            // Exports often repeat a merchant on consecutive rows; skip the cache round trip
+            if (i > begin && sameInput(inputs[i], inputs[i - 1])) {
+                ids[i] = ids[i - 1];
+            } else {
+                ids[i] = categorize(*set, inputs[i]);
             }
         }
+    };
+    if (count < kParallelBatch) {
+        run(0, count);
+    } else {
+        mt::parallelFor(count, kParallelBatch / 4, run);
+    }
+}
+
+std::vector<CategoryId> ConfigManager::categorizeBatch(
+    const std::vector<CategorizationInput>& inputs) const {
+    std::vector<CategoryId> ids(inputs.size());
+    categorizeBatch(inputs.data(), ids.data(), inputs.size());
+    return ids;
+}
+
+void ConfigManager::categorizeBatch(const std::string_view* descriptions, CategoryId* ids,
+                                    size_t count) const {
+    std::vector<CategorizationInput> inputs(count);
+    for (size_t i = 0; i < count; ++i) inputs[i].description = descriptions[i];
+    categorizeBatch(inputs.data(), ids, count);
+}
+
+std::vector<CategoryId> ConfigManager::categorizeBatch(
+    const std::vector<std::string_view>& descriptions) const {
+    std::vector<CategoryId> ids(descriptions.size());
+    categorizeBatch(descriptions.data(), ids.data(), descriptions.size());
+    return ids;
+}
+
+std::string ConfigManager::cacheKey(const RuleSet& set, const CategorizationInput& input) {
+    // Matching is ASCII case-insensitive, so lowercase. When no keyword or pattern uses a
+    // digit, a digit can never be part of a match, and a run of them behaves like a single
+    // one: "STARBUCKS #1234" and "STARBUCKS #5678" then share the key "starbucks #0".
+    // Merchant keys depend on where digit runs fall, not on their length or value, so
+    // overrides agree with the collapsed key.
+    std::string key;
+    key.reserve(input.description.size() + 12);
+    bool collapseDigits = !set.program.usesDigits();
+    for (char ch : input.description) {
+        bool digit = ch >= '0' && ch <= '9';
+        if (digit && collapseDigits) {
+            if (key.empty() || key.back() != '0') key.push_back('0');
+            continue;
+        }
+        key.push_back(ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch - 'A' + 'a') : ch);
+    }
+    set.program.appendContext(input, key);
+    return key;
+}
+
+CategoryConfig ConfigManager::getConfig() const {
+    std::shared_ptr<const RuleSet> set = snapshot();
+    return CategoryConfig{set->rules, set->overrides};
+}
+
+namespace {
+
+bool sameConditions(const CategoryRule& a, const CategoryRule& b) {
+    return a.category == b.category && a.pattern == b.pattern && a.minAmount == b.minAmount &&
+           a.maxAmount == b.maxAmount && a.account == b.account &&
+           a.startDate == b.startDate && a.endDate == b.endDate;
+}
+
+} // namespace
+
+bool ConfigManager::changedKeywords(const CategoryConfig& before, const CategoryConfig& after,
+                                    std::vector<std::string>& keywords) {
+    // Rule i can only change the outcome for a row that the old or the new version of
+    // rule i could match, and a rule with keywords matches only rows containing one of
+    // them. Rules are compared by position, with a missing rule counting as changed.
+    keywords.clear();
+    size_t count = std::max(before.rules.size(), after.rules.size());
+    for (size_t r = 0; r < count; ++r) {
+        const CategoryRule* oldRule = r < before.rules.size() ? &before.rules[r] : nullptr;
+        const CategoryRule* newRule = r < after.rules.size() ? &after.rules[r] : nullptr;
+        if (oldRule && newRule && sameConditions(*oldRule, *newRule)) {
+            // Only the keyword lists can differ: the symmetric difference is enough
+            std::set<std::string> oldKeywords(oldRule->keywords.begin(), oldRule->keywords.end());
+            std::set<std::string> newKeywords(newRule->keywords.begin(), newRule->keywords.end());
+            if (oldKeywords.empty() != newKeywords.empty()) return false;
+            std::set_symmetric_difference(oldKeywords.begin(), oldKeywords.end(),
+                                          newKeywords.begin(), newKeywords.end(),
+                                          std::back_inserter(keywords));
+            continue;
+        }
+        for (const CategoryRule* rule : {oldRule, newRule}) {
+            if (!rule) continue;
+            if (rule->keywords.empty()) return false;
+            keywords.insert(keywords.end(), rule->keywords.begin(), rule->keywords.end());
+        }
+    }
+    
+    // Overrides are keyed by normalized merchant, which is spelled out in the description
+    std::set<std::pair<std::string, std::string>> oldOverrides(before.overrides.begin(),
+                                                               before.overrides.end());
+    std::set<std::pair<std::string, std::string>> newOverrides(after.overrides.begin(),
+                                                               after.overrides.end());
+    std::vector<std::pair<std::string, std::string>> changed;
+    std::set_symmetric_difference(oldOverrides.begin(), oldOverrides.end(),
+                                  newOverrides.begin(), newOverrides.end(),
+                                  std::back_inserter(changed));
+    for (const auto& entry : changed) {
+        keywords.push_back(entry.first);
     }
     
-    return "Other";
+    std::sort(keywords.begin(), keywords.end());
+    keywords.erase(std::unique(keywords.begin(), keywords.end()), keywords.end());
+    return true;
 }
 
 void ConfigManager::loadDefaultCategories() {
-    categories.clear();
+    auto set = std::make_shared<RuleSet>();
+    std::vector<CategoryRule>& rules = set->rules;
     
-    addCategory("Groceries", {
+    addCategory(rules, "Groceries", {
         "grocery", "safeway", "trader", "whole foods", "kroger", "publix",
         "walmart grocery", "costco", "market", "supermarket"
     });
     
-    addCategory("Gas", {
+    addCategory(rules, "Gas", {
         "gas", "fuel", "shell", "chevron", "bp", "exxon", "mobil",
         "texaco", "sunoco", "speedway"
     });
     
-    addCategory("Dining", {
+    addCategory(rules, "Dining", {
         "restaurant", "cafe", "pizza", "burger", "diner", "bar",
         "coffee", "starbucks", "chipotle", "taco bell", "mcdonalds",
         "wendy's", "chick-fil-a", "olive garden", "applebee's",
         "dinner", "lunch", "breakfast", "food delivery"
     });
     
-    addCategory("Shopping", {
+    addCategory(rules, "Shopping", {
         "amazon", "ebay", "walmart", "target", "mall", "store",
         "retail", "boutique", "department store", "costco", "sam's club"
     });
     
-    addCategory("Entertainment", {
+    addCategory(rules, "Entertainment", {
         "netflix", "spotify", "hulu", "disney", "movie", "theater",
         "cinema", "concert", "ticket", "amusement"
     });
     
-    addCategory("Utilities", {
+    addCategory(rules, "Utilities", {
         "electricity", "water", "gas bill", "internet", "cable",
         "phone bill", "electric", "power", "utility"
     });
     
-    addCategory("Healthcare", {
+    addCategory(rules, "Healthcare", {
         "doctor", "hospital", "pharmacy", "dental", "health",
         "medical", "clinic", "cvs", "walgreens"
     });
     
-    addCategory("Transportation", {
+    addCategory(rules, "Transportation", {
         "uber", "lyft", "taxi", "parking", "toll", "transit",
         "bus", "train", "metro", "parking garage"
     });
     
-    addCategory("Subscriptions", {
+    addCategory(rules, "Subscriptions", {
         "subscription", "membership", "prime", "membership fee"
     });
     
-    addCategory("Transfers", {
+    addCategory(rules, "Transfers", {
         "transfer", "deposit", "xfer", "move funds", "wire"
     });
+    
+    set->program.compile(rules);
+    publish(std::move(set));
 }
 
-void ConfigManager::addCategory(const std::string& name, const std::vector<std::string>& keywords) {
+void ConfigManager::addCategory(std::vector<CategoryRule>& rules, const std::string& name,
+                                const std::vector<std::string>& keywords) {
     CategoryRule rule;
     rule.category = name;
     rule.keywords = keywords;
-    categories.push_back(rule);
-}
-
-std::string ConfigManager::toLower(const std::string& str) const {
-    std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
-    return result;
+    rules.push_back(rule);
 }
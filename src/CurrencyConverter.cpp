@@ -0,0 +1,192 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "CurrencyConverter.h"
+#include "DateParser.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+} // namespace
+
+CurrencyConverter::CurrencyConverter(const std::string& reportingCurrency)
+    : reportingCurrency(normalizeCode(reportingCurrency)) {}
+
+void CurrencyConverter::loadRates(const std::string& filePath) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open FX rate file: " + filePath);
+    }
+    
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (trim(line).empty()) continue;
+        
+        std::stringstream ss(line);
+        std::string date, currency, rate;
+        std::getline(ss, date, ',');
+        std::getline(ss, currency, ',');
+        std::getline(ss, rate, ',');
+        
+        double value;
+        try {
+            value = std::stod(trim(rate));
+        } catch (const std::exception&) {
+            if (lineNumber == 1) continue;  // Header row
+            throw std::runtime_error("Invalid FX rate on line " + std::to_string(lineNumber) +
+                                     " of " + filePath);
+        }
+        
+        int day;
+        try {
+            day = DateParser::toDayNumber(DateParser::parse(trim(date)));
+        } catch (const std::exception&) {
+            throw std::runtime_error("Invalid FX date on line " + std::to_string(lineNumber) +
+                                     " of " + filePath);
+        }
+        
+        std::string code = normalizeCode(currency);
+        if (value <= 0 || code.empty()) {
+            throw std::runtime_error("Invalid FX rate on line " + std::to_string(lineNumber) +
+                                     " of " + filePath);
+        }
+        tables[code].quotes.emplace_back(day, value);
+    }
+    
+    for (auto& entry : tables) rebuild(entry.second);
+}
+
+void CurrencyConverter::addRate(const std::string& date, const std::string& currency,
+                                double rate) {
+    if (rate <= 0) {
+        throw std::invalid_argument("FX rates must be positive");
+    }
+    RateTable& target = tables[normalizeCode(currency)];
+    target.quotes.emplace_back(DateParser::toDayNumber(date), rate);
+    rebuild(target);
+}
+
+void CurrencyConverter::rebuild(RateTable& table) {
+    // Later quotes for the same day win
+    std::stable_sort(table.quotes.begin(), table.quotes.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    
+    table.firstDay = table.quotes.front().first;
+    table.daily.assign(table.quotes.back().first - table.firstDay + 1, 0.0);
+    size_t q = 0;
+    for (size_t d = 0; d < table.daily.size(); ++d) {
+        int day = table.firstDay + static_cast<int>(d);
+        while (q + 1 < table.quotes.size() && table.quotes[q + 1].first <= day) q++;
+        table.daily[d] = table.quotes[q].second;
+    }
+}
+
+bool CurrencyConverter::hasRates(const std::string& currency) const {
+    std::string code = normalizeCode(currency);
+    return code == reportingCurrency || tables.count(code) > 0;
+}
+
+const CurrencyConverter::RateTable& CurrencyConverter::table(const std::string& currency) const {
+    auto it = tables.find(normalizeCode(currency));
+    if (it == tables.end()) {
+        throw std::runtime_error("No FX rates for " + currency + " -> " + reportingCurrency);
+    }
+    return it->second;
+}
+
+double CurrencyConverter::getRate(const std::string& currency, int dayNumber) const {
+    if (normalizeCode(currency) == reportingCurrency) return 1.0;
+    const RateTable& rates = table(currency);
+    long index = static_cast<long>(dayNumber) - rates.firstDay;
+    index = std::max(0L, std::min(index, static_cast<long>(rates.daily.size()) - 1));
+    return rates.daily[static_cast<size_t>(index)];
+}
+
+void CurrencyConverter::convert(const std::string& currency, const int* dayNumbers,
+                                double* amounts, size_t count, double* factors) const {
+    if (normalizeCode(currency) == reportingCurrency) {
+        if (factors) std::fill(factors, factors + count, 1.0);
+        return;
+    }
+    const RateTable& rates = table(currency);
+    const double* daily = rates.daily.data();
+    const long last = static_cast<long>(rates.daily.size()) - 1;
+    
+    // Gather the factor column first so the multiply runs over plain contiguous arrays
+    std::vector<double> scratch;
+    if (!factors) {
+        scratch.resize(count);
+        factors = scratch.data();
+    }
+    for (size_t i = 0; i < count; ++i) {
+        long index = static_cast<long>(dayNumbers[i]) - rates.firstDay;
+        factors[i] = daily[std::max(0L, std::min(index, last))];
+    }
+    for (size_t i = 0; i < count; ++i) {
+        amounts[i] *= factors[i];
+    }
+}
+
+void CurrencyConverter::convert(std::vector<Transaction>& transactions) const {
+    // Group rows by currency; a statement export normally holds a single currency
+    std::unordered_map<std::string, std::vector<size_t>> byCurrency;
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        std::string code = normalizeCode(transactions[i].currency);
+        if (code.empty() || code == reportingCurrency) continue;
+        byCurrency[code].push_back(i);
+    }
+    
+    std::vector<int> days;
+    std::vector<double> amounts;
+    std::vector<double> factors;
+    for (const auto& group : byCurrency) {
+        const std::vector<size_t>& rows = group.second;
+        days.resize(rows.size());
+        amounts.resize(rows.size());
+        factors.resize(rows.size());
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const Transaction& t = transactions[rows[i]];
+            days[i] = DateParser::toDayNumber(t.date);
+            amounts[i] = t.amount;
+        }
+        
+        convert(group.first, days.data(), amounts.data(), rows.size(), factors.data());
+        
+        for (size_t i = 0; i < rows.size(); ++i) {
+            Transaction& t = transactions[rows[i]];
+            t.amount = amounts[i];
+            t.fxRate = factors[i];
+        }
+    }
+}
+
+std::string CurrencyConverter::normalizeCode(const std::string& currency) {
+    std::string result;
+    for (unsigned char c : currency) {
+        if (!std::isspace(c)) result += static_cast<char>(std::toupper(c));
+    }
+    return result;
+}
+
+std::string CurrencyConverter::symbol(const std::string& currency) {
+    std::string code = normalizeCode(currency);
+    if (code == "USD") return "$";
+    if (code == "EUR") return "\xE2\x82\xAC";
+    if (code == "GBP") return "\xC2\xA3";
+    if (code == "JPY") return "\xC2\xA5";
+    return code + " ";
+}
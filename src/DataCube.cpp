@@ -0,0 +1,235 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "DataCube.h"
+#include "DateParser.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+
+// Months since year 0, or INT_MIN when the date is not a valid YYYY-MM-DD
+int monthKey(const std::string& date) {
+    int dayNumber;
+    if (!DateParser::tryDayNumber(date, dayNumber)) return INT_MIN;
+    int year = (date[0] - '0') * 1000 + (date[1] - '0') * 100 + (date[2] - '0') * 10 +
+               (date[3] - '0');
+    int month = (date[5] - '0') * 10 + (date[6] - '0');
+    return year * 12 + (month - 1);
+}
+
+size_t axisId(CubeAxis axis) {
+    return static_cast<size_t>(axis);
+}
+
+// Sorts interned labels in place and returns old id -> new id
+std::vector<size_t> sortLabels(std::vector<std::string>& labels,
+                               std::unordered_map<std::string, size_t>& index) {
+    std::vector<size_t> order(labels.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(),
+              [&labels](size_t a, size_t b) { return labels[a] < labels[b]; });
+    
+    std::vector<size_t> remap(labels.size());
+    std::vector<std::string> sorted(labels.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        remap[order[i]] = i;
+        sorted[i] = std::move(labels[order[i]]);
+        index[sorted[i]] = i;
+    }
+    labels = std::move(sorted);
+    return remap;
+}
+
+} // namespace
+
+DataCube::DataCube(const TransactionData& data, const std::vector<bool>& excluded)
+    : firstMonth(INT_MAX), periodSlots(1) {
+    const auto& transactions = data.getAllTransactions();
+    auto& categories = axisLabels[axisId(CubeAxis::Category)];
+    auto& accounts = axisLabels[axisId(CubeAxis::Account)];
+    auto& categoryIndex = axisIndex[axisId(CubeAxis::Category)];
+    auto& accountIndex = axisIndex[axisId(CubeAxis::Account)];
+    
+    // Pass 1: intern categories and accounts and find the month range
+    std::vector<size_t> rowCategory(transactions.size());
+    std::vector<size_t> rowAccount(transactions.size());
+    std::vector<int> rowMonth(transactions.size());
+    int lastMonth = INT_MIN;
+    
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        if (i < excluded.size() && excluded[i]) continue;
+        const auto& t = transactions[i];
+        rowCategory[i] = categoryIndex.emplace(t.category, categories.size()).first->second;
+        if (rowCategory[i] == categories.size()) categories.push_back(t.category);
+        rowAccount[i] = accountIndex.emplace(t.accountName, accounts.size()).first->second;
+        if (rowAccount[i] == accounts.size()) accounts.push_back(t.accountName);
+        
+        rowMonth[i] = monthKey(t.date);
+        if (rowMonth[i] != INT_MIN) {
+            firstMonth = std::min(firstMonth, rowMonth[i]);
+            lastMonth = std::max(lastMonth, rowMonth[i]);
+        }
+    }
+    
+    std::vector<size_t> categoryRemap = sortLabels(categories, categoryIndex);
+    std::vector<size_t> accountRemap = sortLabels(accounts, accountIndex);
+    
+    size_t months = firstMonth > lastMonth ? 0 : static_cast<size_t>(lastMonth - firstMonth) + 1;
+    auto& periods = axisLabels[axisId(CubeAxis::Period)];
+    char label[16];
+    for (size_t p = 0; p < months; ++p) {
+        int key = firstMonth + static_cast<int>(p);
+        snprintf(label, sizeof(label), "%04d-%02d", key / 12, key % 12 + 1);
+        periods.push_back(label);
+        axisIndex[axisId(CubeAxis::Period)][label] = p;
+    }
+    
+    // Pass 2: accumulate into the dense cells
+    periodSlots = months + 1;
+    cells.assign(categories.size() * accounts.size() * periodSlots, CubeCell());
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        if (i < excluded.size() && excluded[i]) continue;
+        size_t period = rowMonth[i] == INT_MIN ? months
+                                               : static_cast<size_t>(rowMonth[i] - firstMonth);
+        CubeCell& target =
+            cells[offset(categoryRemap[rowCategory[i]], accountRemap[rowAccount[i]]) + period];
+        double amount = transactions[i].amount;
+        if (amount < 0) {
+            target.spending += amount;
+        } else {
+            target.income += amount;
+        }
+        target.count++;
+    }
+}
+
+std::shared_ptr<DataCube> DataCube::withCategoryChanges(
+    const TransactionData& data, const std::vector<CategoryChange>& changes,
+    const std::vector<bool>& excluded) const {
+    const auto& transactions = data.getAllTransactions();
+    const auto& categoryIndex = axisIndex[axisId(CubeAxis::Category)];
+    const auto& accountIndex = axisIndex[axisId(CubeAxis::Account)];
+    size_t months = periodSlots - 1;
+    
+    auto patched = std::make_shared<DataCube>(*this);
+    std::vector<uint32_t> categoryCounts(axisLabels[axisId(CubeAxis::Category)].size(), 0);
+    for (const auto& change : changes) {
+        if (change.row >= transactions.size()) return nullptr;
+        if (change.row < excluded.size() && excluded[change.row]) continue;
+        auto from = categoryIndex.find(change.from);
+        auto to = categoryIndex.find(change.to);
+        const auto& t = transactions[change.row];
+        auto account = accountIndex.find(t.accountName);
+        if (from == categoryIndex.end() || to == categoryIndex.end() ||
+            account == accountIndex.end()) {
+            return nullptr;
+        }
+        
+        int month = monthKey(t.date);
+        size_t period = month == INT_MIN ? months : static_cast<size_t>(month - firstMonth);
+        if (period > months) return nullptr;
+        CubeCell& source = patched->cells[offset(from->second, account->second) + period];
+        CubeCell& target = patched->cells[offset(to->second, account->second) + period];
+        if (source.count == 0) return nullptr;
+        if (t.amount < 0) {
+            source.spending -= t.amount;
+            target.spending += t.amount;
+        } else {
+            source.income -= t.amount;
+            target.income += t.amount;
+        }
+        source.count--;
+        target.count++;
+    }
+    
+    // Every category label must still own at least one row
+    std::vector<CubeCell> byCategory = patched->rollUp(CubeAxis::Category);
+    for (const auto& cell : byCategory) {
+        if (cell.count == 0) return nullptr;
+    }
+    return patched;
+}
+
+size_t DataCube::size(CubeAxis axis) const {
+    return axisLabels[axisId(axis)].size();
+}
+
+const std::vector<std::string>& DataCube::labels(CubeAxis axis) const {
+    return axisLabels[axisId(axis)];
+}
+
+size_t DataCube::find(CubeAxis axis, const std::string& label) const {
+    const auto& index = axisIndex[axisId(axis)];
+    auto it = index.find(label);
+    return it == index.end() ? npos : it->second;
+}
+
+template <typename Visit>
+void DataCube::forEachCell(Visit visit) const {
+    size_t coords[3];
+    size_t& category = coords[0];
+    size_t& account = coords[1];
+    size_t& period = coords[2];
+    for (category = 0; category < axisLabels[0].size(); ++category) {
+        for (account = 0; account < axisLabels[1].size(); ++account) {
+            const CubeCell* run = series(category, account);
+            for (period = 0; period < periodSlots; ++period) {
+                if (run[period].count > 0) visit(coords, run[period]);
+            }
+        }
+    }
+}
+
+CubeCell DataCube::total() const {
+    CubeCell result;
+    forEachCell([&result](const size_t*, const CubeCell& cell) { result.add(cell); });
+    return result;
+}
+
+std::vector<CubeCell> DataCube::rollUp(CubeAxis axis) const {
+    size_t id = axisId(axis);
+    size_t limit = size(axis);
+    std::vector<CubeCell> result(limit);
+    forEachCell([&](const size_t* coords, const CubeCell& cell) {
+        // The undated slot falls outside the period axis
+        if (coords[id] < limit) result[coords[id]].add(cell);
+    });
+    return result;
+}
+
+std::vector<CubeCell> DataCube::pivot(CubeAxis rows, CubeAxis columns) const {
+    if (rows == columns) {
+        throw std::invalid_argument("pivot axes must differ");
+    }
+    size_t r = axisId(rows), c = axisId(columns);
+    size_t rowCount = size(rows), columnCount = size(columns);
+    std::vector<CubeCell> result(rowCount * columnCount);
+    forEachCell([&](const size_t* coords, const CubeCell& cell) {
+        if (coords[r] < rowCount && coords[c] < columnCount) {
+            result[coords[r] * columnCount + coords[c]].add(cell);
+        }
+    });
+    return result;
+}
+
+std::vector<CubeCell> DataCube::slice(CubeAxis fixed, size_t index, CubeAxis rows,
+                                      CubeAxis columns) const {
+    if (rows == columns || fixed == rows || fixed == columns) {
+        throw std::invalid_argument("slice axes must all differ");
+    }
+    if (index >= size(fixed)) {
+        throw std::out_of_range("slice index outside the cube");
+    }
+    size_t f = axisId(fixed), r = axisId(rows), c = axisId(columns);
+    size_t rowCount = size(rows), columnCount = size(columns);
+    std::vector<CubeCell> result(rowCount * columnCount);
+    forEachCell([&](const size_t* coords, const CubeCell& cell) {
+        if (coords[f] == index && coords[r] < rowCount && coords[c] < columnCount) {
+            result[coords[r] * columnCount + coords[c]].add(cell);
+        }
+    });
+    return result;
+}
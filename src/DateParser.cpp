@@ -81,6 +81,51 @@ std::string DateParser::extractMonth(const std::string& dateStr) {
     return normalized.substr(0, 7);
 }
 
+int DateParser::toDayNumber(const std::string& normalizedDate) {
+    int dayNumber;
+    if (!tryDayNumber(normalizedDate, dayNumber)) {
+        throw std::invalid_argument("Expected YYYY-MM-DD date: " + normalizedDate);
+    }
+    return dayNumber;
+}
+
+bool DateParser::tryDayNumber(const std::string& normalizedDate, int& dayNumber) {
+    const std::string& d = normalizedDate;
+    if (d.size() < 10 || d[4] != '-' || d[7] != '-') return false;
+    for (size_t i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+        if (d[i] < '0' || d[i] > '9') return false;
+    }
+    int year = (d[0] - '0') * 1000 + (d[1] - '0') * 100 + (d[2] - '0') * 10 + (d[3] - '0');
+    int month = (d[5] - '0') * 10 + (d[6] - '0');
+    int day = (d[8] - '0') * 10 + (d[9] - '0');
+    if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+    
+    // Days-from-civil (proleptic Gregorian), see H. Hinnant's date algorithms
+    year -= month <= 2 ? 1 : 0;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yoe = year - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    dayNumber = era * 146097 + doe - 719468;
+    return true;
+}
+
+std::string DateParser::fromDayNumber(int dayNumber) {
+    int z = dayNumber + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    int day = doy - (153 * mp + 2) / 5 + 1;
+    int month = mp + (mp < 10 ? 3 : -9);
+    int year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+    
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+    return std::string(buffer);
+}
+
 int DateParser::detectFormat(const std::string& dateStr) {
     // Try to determine if it's MM/DD/YYYY or DD/MM/YYYY or YYYY/MM/DD
     std::string cleanDate = dateStr;
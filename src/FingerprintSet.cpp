@@ -0,0 +1,65 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "FingerprintSet.h"
+
+namespace {
+
+const size_t kMinCapacity = 16;
+
+size_t capacityFor(size_t expected) {
+    size_t capacity = kMinCapacity;
+    while (capacity < expected * 2) capacity <<= 1;
+    return capacity;
+}
+
+} // namespace
+
+FingerprintSet::FingerprintSet(size_t expected)
+    : slots(capacityFor(expected), 0), count(0), mask(slots.size() - 1) {}
+
+bool FingerprintSet::insert(uint64_t fingerprint) {
+    if ((count + 1) * 2 > slots.size()) rehash(slots.size() * 2);
+    
+    uint64_t k = key(fingerprint);
+    for (size_t i = static_cast<size_t>(k) & mask;; i = (i + 1) & mask) {
+        if (slots[i] == k) return false;
+        if (slots[i] == 0) {
+            slots[i] = k;
+            count++;
+            return true;
+        }
+    }
+}
+
+bool FingerprintSet::contains(uint64_t fingerprint) const {
+    uint64_t k = key(fingerprint);
+    for (size_t i = static_cast<size_t>(k) & mask;; i = (i + 1) & mask) {
+        if (slots[i] == k) return true;
+        if (slots[i] == 0) return false;
+    }
+}
+
+void FingerprintSet::reserve(size_t expected) {
+    size_t capacity = capacityFor(expected);
+    if (capacity > slots.size()) rehash(capacity);
+}
+
+void FingerprintSet::clear() {
+    slots.assign(kMinCapacity, 0);
+    mask = kMinCapacity - 1;
+    count = 0;
+}
+
+void FingerprintSet::rehash(size_t capacity) {
+    std::vector<uint64_t> old;
+    old.swap(slots);
+    slots.assign(capacity, 0);
+    mask = capacity - 1;
+    for (uint64_t k : old) {
+        if (k == 0) continue;
+        size_t i = static_cast<size_t>(k) & mask;
+        while (slots[i] != 0) i = (i + 1) & mask;
+        slots[i] = k;
+    }
+}
@@ -0,0 +1,180 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "Forecaster.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const size_t kSeason = 12;
+const double kDamping = 0.9;
+const size_t kGroupsPerTask = 64;
+
+struct Fit {
+    double sse;
+    const char* method;
+};
+
+// Additive Holt-Winters; writes `horizon` forecasts to out and returns the one-step SSE
+double holtWinters(const double* y, size_t n, double alpha, double beta, double gamma,
+                   size_t horizon, double* out) {
+    double level = 0.0, next = 0.0;
+    for (size_t i = 0; i < kSeason; ++i) {
+        level += y[i];
+        next += y[kSeason + i];
+    }
+    level /= kSeason;
+    double trend = (next / kSeason - level) / kSeason;
+    
+    // The first-season mean sits mid-season; detrend the seasonal indices around it and
+    // advance the level to the end of the season where smoothing starts
+    const double center = (kSeason - 1) / 2.0;
+    double seasonal[kSeason];
+    for (size_t i = 0; i < kSeason; ++i) seasonal[i] = y[i] - (level + (i - center) * trend);
+    level += center * trend;
+
+    double sse = 0.0;
+    for (size_t t = kSeason; t < n; ++t) {
+        double& s = seasonal[t % kSeason];
+        double error = y[t] - (level + trend + s);
+        sse += error * error;
+        double previous = level;
+        level = alpha * (y[t] - s) + (1 - alpha) * (level + trend);
+        trend = beta * (level - previous) + (1 - beta) * trend;
+        s = gamma * (y[t] - level) + (1 - gamma) * s;
+    }
+    for (size_t h = 1; h <= horizon; ++h) {
+        out[h - 1] = level + h * trend + seasonal[(n + h - 1) % kSeason];
+    }
+    return sse;
+}
+
+// Damped-trend Holt; writes `horizon` forecasts to out and returns the one-step SSE
+double dampedHolt(const double* y, size_t n, double alpha, double beta, size_t horizon,
+                  double* out) {
+    double level = y[0];
+    double trend = y[1] - y[0];
+    double sse = 0.0;
+    for (size_t t = 1; t < n; ++t) {
+        double error = y[t] - (level + kDamping * trend);
+        sse += error * error;
+        double previous = level;
+        level = alpha * y[t] + (1 - alpha) * (level + kDamping * trend);
+        trend = beta * (level - previous) + (1 - beta) * kDamping * trend;
+    }
+    double damping = 0.0, factor = 1.0;
+    for (size_t h = 1; h <= horizon; ++h) {
+        factor *= kDamping;
+        damping += factor;
+        out[h - 1] = level + damping * trend;
+    }
+    return sse;
+}
+
+Fit fitSeries(const double* y, size_t n, size_t horizon, double* out) {
+    std::vector<double> candidate(horizon);
+    Fit best{std::numeric_limits<double>::infinity(), "Mean"};
+
+    if (n >= 2 * kSeason) {
+        for (double alpha : {0.1, 0.3, 0.5}) {
+            for (double beta : {0.01, 0.1}) {
+                for (double gamma : {0.1, 0.3}) {
+                    double sse = holtWinters(y, n, alpha, beta, gamma, horizon, candidate.data());
+                    if (sse < best.sse) {
+                        best = {sse, "Holt-Winters"};
+                        std::copy(candidate.begin(), candidate.end(), out);
+                    }
+                }
+            }
+        }
+    } else if (n >= 3) {
+        for (double alpha : {0.1, 0.3, 0.5, 0.7, 0.9}) {
+            for (double beta : {0.05, 0.1, 0.2}) {
+                double sse = dampedHolt(y, n, alpha, beta, horizon, candidate.data());
+                if (sse < best.sse) {
+                    best = {sse, "Holt"};
+                    std::copy(candidate.begin(), candidate.end(), out);
+                }
+            }
+        }
+    } else {
+        double mean = 0.0;
+        for (size_t i = 0; i < n; ++i) mean += y[i];
+        mean = n > 0 ? mean / n : 0.0;
+        std::fill(out, out + horizon, mean);
+    }
+
+    // Spending cannot go negative
+    for (size_t h = 0; h < horizon; ++h) out[h] = std::max(0.0, out[h]);
+    return best;
+}
+
+} // namespace
+
+SpendingForecaster::SpendingForecaster(size_t horizon) : horizon(std::max<size_t>(1, horizon)) {}
+
+std::vector<double> SpendingForecaster::forecastMatrix(const std::vector<double>& series,
+                                                       size_t groups, size_t months,
+                                                       std::vector<std::string>* methods) const {
+    std::vector<double> result(groups * horizon, 0.0);
+    std::vector<const char*> chosen(groups, "Mean");
+
+    mt::parallelFor(groups, kGroupsPerTask, [&](size_t begin, size_t end) {
+        for (size_t g = begin; g < end; ++g) {
+            chosen[g] = fitSeries(&series[g * months], months, horizon, &result[g * horizon]).method;
+        }
+    });
+
+    if (methods) methods->assign(chosen.begin(), chosen.end());
+    return result;
+}
+
+ForecastResult SpendingForecaster::forecast(const TransactionData& data) const {
+    return forecast(DataCube(data));
+}
+
+ForecastResult SpendingForecaster::forecast(const DataCube& cube) const {
+    ForecastResult result;
+    size_t months = cube.size(CubeAxis::Period);
+    if (months == 0) return result;
+    
+    // Gather every (category, account) pair with spending into one contiguous matrix
+    const auto& categories = cube.labels(CubeAxis::Category);
+    const auto& accounts = cube.labels(CubeAxis::Account);
+    std::vector<double> series;
+    for (size_t c = 0; c < categories.size(); ++c) {
+        for (size_t a = 0; a < accounts.size(); ++a) {
+            const CubeCell* run = cube.series(c, a);
+            bool spent = false;
+            for (size_t m = 0; m < months && !spent; ++m) spent = run[m].spending < 0;
+            if (!spent) continue;
+            
+            result.groups.push_back({categories[c], accounts[a], "", {}});
+            for (size_t m = 0; m < months; ++m) series.push_back(-run[m].spending);
+        }
+    }
+    if (result.groups.empty()) return result;
+    
+    std::vector<std::string> methods;
+    std::vector<double> values = forecastMatrix(series, result.groups.size(), months, &methods);
+    for (size_t g = 0; g < result.groups.size(); ++g) {
+        result.groups[g].method = methods[g];
+        result.groups[g].values.assign(values.begin() + g * horizon,
+                                       values.begin() + (g + 1) * horizon);
+    }
+    
+    // Cube periods are contiguous YYYY-MM labels; continue them past the last one
+    const std::string& last = cube.labels(CubeAxis::Period).back();
+    int lastMonth = std::stoi(last.substr(0, 4)) * 12 + std::stoi(last.substr(5, 2)) - 1;
+    char label[16];
+    for (size_t h = 1; h <= horizon; ++h) {
+        int key = lastMonth + static_cast<int>(h);
+        snprintf(label, sizeof(label), "%04d-%02d", key / 12, key % 12 + 1);
+        result.months.push_back(label);
+    }
+    return result;
+}
@@ -0,0 +1,241 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "FuzzyMatcher.h"
+#include "ConfigManager.h"
+#include "MerchantNormalizer.h"
+#include "Parallel.h"
+#include "TransactionData.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+std::string trim(const std::string& s) {
+    size_t first = s.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) return "";
+    size_t last = s.find_last_not_of(" \t\r\n");
+    return s.substr(first, last - first + 1);
+}
+
+} // namespace
+
+FuzzyMatcher::FuzzyMatcher(double threshold) : threshold(threshold) {
+    if (!(threshold > 0.0 && threshold <= 1.0)) {
+        throw std::invalid_argument("Fuzzy match threshold must be in (0, 1]");
+    }
+    gramStart.push_back(0);
+    postingStart.push_back(0);
+}
+
+void FuzzyMatcher::add(std::string_view merchant, const std::string& category) {
+    std::string key = normalizeMerchant(merchant);
+    if (key.empty() || category.empty()) return;
+    if (!merchantIds.emplace(key, static_cast<uint32_t>(merchants.size())).second) return;
+
+    auto inserted = categoryIds.emplace(category, static_cast<uint32_t>(categories.size()));
+    if (inserted.second) categories.push_back(category);
+    merchants.push_back(std::move(key));
+    merchantCategory.push_back(inserted.first->second);
+}
+
+void FuzzyMatcher::addHistory(const TransactionData& data, const std::string& uncategorized) {
+    // merchant -> category -> rows; merchants are visited in first-seen order
+    std::unordered_map<const std::string*, std::unordered_map<std::string, size_t>> counts;
+    std::vector<const std::string*> order;
+    for (const auto& t : data.getAllTransactions()) {
+        if (t.category.empty() || t.category == uncategorized) continue;
+        const std::string& merchant = merchantKey(t);
+        if (merchant.empty()) continue;
+        auto& byCategory = counts[&merchant];
+        if (byCategory.empty()) order.push_back(&merchant);
+        byCategory[t.category]++;
+    }
+
+    for (const std::string* merchant : order) {
+        const auto& byCategory = counts[merchant];
+        auto best = byCategory.begin();
+        for (auto it = byCategory.begin(); it != byCategory.end(); ++it) {
+            if (it->second > best->second ||
+                (it->second == best->second && it->first < best->first)) {
+                best = it;
+            }
+        }
+        add(*merchant, best->first);
+    }
+}
+
+size_t FuzzyMatcher::loadDictionary(const std::string& filePath) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open merchant dictionary: " + filePath);
+    }
+
+    std::string line;
+    size_t lineNumber = 0;
+    size_t entries = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t split = line.rfind(',');
+        std::string merchant = split == std::string::npos ? "" : trim(line.substr(0, split));
+        std::string category = split == std::string::npos ? "" : trim(line.substr(split + 1));
+        if (lineNumber == 1 && merchant == "merchant" && category == "category") continue;
+        if (merchant.empty() || category.empty()) {
+            throw std::runtime_error("Invalid merchant entry on line " +
+                                     std::to_string(lineNumber) + " of " + filePath);
+        }
+        add(merchant, category);
+        entries++;
+    }
+    return entries;
+}
+
+void FuzzyMatcher::trigrams(std::string_view merchant, std::vector<uint32_t>& out) {
+    // Two leading pads and one trailing pad weight the start of a name, where merchants differ
+    out.clear();
+    std::string padded = "  " + std::string(merchant) + " ";
+    for (size_t i = 0; i + 3 <= padded.size(); ++i) {
+        out.push_back(static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16 |
+                      static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8 |
+                      static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2])));
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void FuzzyMatcher::build() {
+    gramStart.assign(1, 0);
+    grams.clear();
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;  // (trigram, merchant)
+    std::vector<uint32_t> buffer;
+    for (size_t m = 0; m < merchants.size(); ++m) {
+        trigrams(merchants[m], buffer);
+        grams.insert(grams.end(), buffer.begin(), buffer.end());
+        gramStart.push_back(static_cast<uint32_t>(grams.size()));
+        for (uint32_t gram : buffer) pairs.emplace_back(gram, static_cast<uint32_t>(m));
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    trigramKeys.clear();
+    postingStart.clear();
+    postings.clear();
+    postings.reserve(pairs.size());
+    for (const auto& pair : pairs) {
+        if (trigramKeys.empty() || trigramKeys.back() != pair.first) {
+            trigramKeys.push_back(pair.first);
+            postingStart.push_back(static_cast<uint32_t>(postings.size()));
+        }
+        postings.push_back(pair.second);
+    }
+    postingStart.push_back(static_cast<uint32_t>(postings.size()));
+    cache.clear();
+}
+
+uint32_t FuzzyMatcher::lookup(const std::string& merchant) const {
+    if (merchant.empty()) return npos;
+    auto exact = merchantIds.find(merchant);
+    if (exact != merchantIds.end()) return merchantCategory[exact->second];
+
+    CategoryId cached;
+    if (cache.lookup(merchant, cached)) return cached;
+
+    thread_local std::vector<uint32_t> query;
+    thread_local std::vector<std::pair<uint32_t, uint32_t>> lists;  // (length, trigram index)
+    thread_local std::vector<uint32_t> candidates;
+    thread_local std::vector<uint32_t> stamps;
+    thread_local uint32_t epoch = 0;
+    trigrams(merchant, query);
+    size_t n = query.size();
+
+    // Rarest trigrams first; trigrams absent from the index cost nothing
+    lists.clear();
+    for (uint32_t gram : query) {
+        auto it = std::lower_bound(trigramKeys.begin(), trigramKeys.end(), gram);
+        if (it == trigramKeys.end() || *it != gram) {
+            lists.emplace_back(0, npos);
+            continue;
+        }
+        uint32_t k = static_cast<uint32_t>(it - trigramKeys.begin());
+        lists.emplace_back(postingStart[k + 1] - postingStart[k], k);
+    }
+    std::sort(lists.begin(), lists.end());
+
+    size_t required = static_cast<size_t>(std::ceil(threshold * n - 1e-9));
+    size_t prefix = n - std::max<size_t>(required, 1) + 1;
+    // Deduplicate through per-thread stamps instead of sorting the merged postings
+    if (stamps.size() < merchants.size()) stamps.resize(merchants.size(), 0);
+    if (++epoch == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        epoch = 1;
+    }
+    candidates.clear();
+    for (size_t i = 0; i < prefix; ++i) {
+        if (lists[i].second == npos) continue;
+        uint32_t k = lists[i].second;
+        for (uint32_t p = postingStart[k]; p < postingStart[k + 1]; ++p) {
+            uint32_t m = postings[p];
+            size_t size = gramStart[m + 1] - gramStart[m];
+            if (stamps[m] == epoch || size < threshold * n || size * threshold > n) continue;
+            stamps[m] = epoch;
+            candidates.push_back(m);
+        }
+    }
+
+    uint32_t best = npos;
+    double bestScore = 0.0;
+    for (uint32_t m : candidates) {
+        size_t size = gramStart[m + 1] - gramStart[m];
+        const uint32_t* a = query.data();
+        const uint32_t* aEnd = a + n;
+        const uint32_t* b = grams.data() + gramStart[m];
+        const uint32_t* bEnd = grams.data() + gramStart[m + 1];
+        size_t overlap = 0;
+        while (a != aEnd && b != bEnd) {
+            if (*a < *b) {
+                ++a;
+            } else if (*b < *a) {
+                ++b;
+            } else {
+                ++overlap;
+                ++a;
+                ++b;
+            }
+        }
+        double score = static_cast<double>(overlap) / static_cast<double>(n + size - overlap);
+        if (score > bestScore || (score == bestScore && best != npos && m < best)) {
+            bestScore = score;
+            best = m;
+        }
+    }
+
+    uint32_t category = best != npos && bestScore >= threshold ? merchantCategory[best] : npos;
+    cache.insert(merchant, category);
+    return category;
+}
+
+std::string FuzzyMatcher::match(const std::string& merchant) const {
+    uint32_t category = lookup(merchant);
+    return category == npos ? std::string() : categories[category];
+}
+
+std::vector<std::string> FuzzyMatcher::suggest(
+    const std::vector<const Transaction*>& rows) const {
+    std::vector<std::string> result(rows.size());
+    auto run = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t category = lookup(merchantKey(*rows[i]));
+            if (category != npos) result[i] = categories[category];
+        }
+    };
+    if (rows.size() < ConfigManager::kParallelBatch) {
+        run(0, rows.size());
+    } else {
+        mt::parallelFor(rows.size(), ConfigManager::kParallelBatch / 4, run);
+    }
+    return result;
+}
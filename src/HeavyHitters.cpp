@@ -0,0 +1,105 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "HeavyHitters.h"
+#include <algorithm>
+
+SpaceSaving::SpaceSaving(size_t capacity) : maxCounters(std::max<size_t>(1, capacity)) {}
+
+SpaceSaving::SpaceSaving(const SpaceSaving& other)
+    : maxCounters(other.maxCounters), counters(other.counters) {
+    for (const auto& entry : counters) {
+        order.insert({entry.second.weight, &entry.first});
+    }
+}
+
+SpaceSaving& SpaceSaving::operator=(const SpaceSaving& other) {
+    if (this != &other) {
+        maxCounters = other.maxCounters;
+        counters = other.counters;
+        order.clear();
+        for (const auto& entry : counters) {
+            order.insert({entry.second.weight, &entry.first});
+        }
+    }
+    return *this;
+}
+
+double SpaceSaving::minWeight() const {
+    if (counters.size() < maxCounters || order.empty()) return 0.0;
+    return order.begin()->first;
+}
+
+void SpaceSaving::update(const std::string& key, double weight, double error) {
+    auto it = counters.find(key);
+    if (it != counters.end()) {
+        order.erase({it->second.weight, &it->first});
+        it->second.weight += weight;
+        it->second.error += error;
+    } else {
+        it = counters.emplace(key, Counter{weight, error}).first;
+    }
+    order.insert({it->second.weight, &it->first});
+}
+
+void SpaceSaving::add(const std::string& key, double weight) {
+    if (counters.count(key) || counters.size() < maxCounters) {
+        update(key, weight, 0.0);
+        return;
+    }
+
+    // Replace the lightest counter; the newcomer inherits its weight as error
+    auto lightest = order.begin();
+    double floor = lightest->first;
+    const std::string* evicted = lightest->second;
+    order.erase(lightest);
+    counters.erase(*evicted);
+    update(key, floor + weight, floor);
+}
+
+void SpaceSaving::merge(const SpaceSaving& other) {
+    // A key missing from a full summary may have had up to that summary's minimum weight
+    double ownFloor = minWeight();
+    double otherFloor = other.minWeight();
+
+    std::unordered_map<std::string, Counter> combined;
+    combined.reserve(counters.size() + other.counters.size());
+    for (const auto& entry : counters) {
+        auto found = other.counters.find(entry.first);
+        if (found != other.counters.end()) {
+            combined[entry.first] = {entry.second.weight + found->second.weight,
+                                     entry.second.error + found->second.error};
+        } else {
+            combined[entry.first] = {entry.second.weight + otherFloor,
+                                     entry.second.error + otherFloor};
+        }
+    }
+    for (const auto& entry : other.counters) {
+        if (!counters.count(entry.first)) {
+            combined[entry.first] = {entry.second.weight + ownFloor, entry.second.error + ownFloor};
+        }
+    }
+
+    std::vector<std::pair<std::string, Counter>> ranked(combined.begin(), combined.end());
+    if (ranked.size() > maxCounters) {
+        std::nth_element(
+            ranked.begin(), ranked.begin() + maxCounters, ranked.end(),
+            [](const auto& a, const auto& b) { return a.second.weight > b.second.weight; });
+        ranked.resize(maxCounters);
+    }
+
+    counters.clear();
+    order.clear();
+    for (const auto& entry : ranked) {
+        update(entry.first, entry.second.weight, entry.second.error);
+    }
+}
+
+std::vector<HeavyHitter> SpaceSaving::top(size_t limit) const {
+    std::vector<HeavyHitter> result;
+    for (auto it = order.rbegin(); it != order.rend() && result.size() < limit; ++it) {
+        const Counter& counter = counters.at(*it->second);
+        result.push_back({*it->second, counter.weight, counter.error});
+    }
+    return result;
+}
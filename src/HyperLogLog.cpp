@@ -0,0 +1,53 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "HyperLogLog.h"
+#include "Hashing.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+HyperLogLog::HyperLogLog(uint8_t precision)
+    : precision(std::min<uint8_t>(18, std::max<uint8_t>(4, precision))),
+      registers(size_t(1) << this->precision, 0) {}
+
+void HyperLogLog::add(std::string_view key) {
+    addHash(mt::hashBytes(key));
+}
+
+void HyperLogLog::addHash(uint64_t hash) {
+    size_t index = hash >> (64 - precision);
+    uint64_t rest = hash << precision;
+    // Position of the first set bit in the remaining 64 - p bits
+    uint8_t rank = rest == 0 ? static_cast<uint8_t>(64 - precision + 1)
+                             : static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    registers[index] = std::max(registers[index], rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    if (other.precision != precision) {
+        throw std::invalid_argument("Cannot merge HyperLogLog counters of different precision");
+    }
+    for (size_t i = 0; i < registers.size(); ++i) {
+        registers[i] = std::max(registers[i], other.registers[i]);
+    }
+}
+
+double HyperLogLog::estimate() const {
+    double m = static_cast<double>(registers.size());
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (uint8_t r : registers) {
+        sum += std::ldexp(1.0, -r);
+        zeros += (r == 0);
+    }
+
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double raw = alpha * m * m / sum;
+
+    // Linear counting is more accurate while many registers are still empty
+    if (raw <= 2.5 * m && zeros > 0) {
+        return m * std::log(m / static_cast<double>(zeros));
+    }
+    return raw;
+}
@@ -0,0 +1,229 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "JsonReader.h"
+#include <cstdlib>
+#include <stdexcept>
+
+JsonReader::JsonReader(std::string_view document) : text(document), pos(0) {
+}
+
+void JsonReader::fail(const std::string& what) const {
+    throw std::runtime_error("JSON error at byte " + std::to_string(pos) + ": " + what);
+}
+
+void JsonReader::skipWhitespace() {
+    while (pos < text.size() &&
+           (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) {
+        pos++;
+    }
+}
+
+char JsonReader::next() {
+    if (pos >= text.size()) fail("unexpected end of input");
+    return text[pos++];
+}
+
+void JsonReader::expect(char c) {
+    skipWhitespace();
+    if (pos >= text.size() || text[pos] != c) fail(std::string("expected '") + c + "'");
+    pos++;
+}
+
+void JsonReader::expectWord(std::string_view word) {
+    if (text.substr(pos, word.size()) != word) fail("invalid literal");
+    pos += word.size();
+}
+
+JsonReader::Type JsonReader::peek() {
+    skipWhitespace();
+    if (pos >= text.size()) return Type::End;
+    switch (text[pos]) {
+    case '{': return Type::Object;
+    case '[': return Type::Array;
+    case '"': return Type::String;
+    case 't':
+    case 'f': return Type::Boolean;
+    case 'n': return Type::Null;
+    default:
+        if (text[pos] == '-' || (text[pos] >= '0' && text[pos] <= '9')) return Type::Number;
+        fail(std::string("unexpected character '") + text[pos] + "'");
+    }
+}
+
+void JsonReader::beginObject() {
+    expect('{');
+    pendingComma.push_back(false);
+}
+
+void JsonReader::beginArray() {
+    expect('[');
+    pendingComma.push_back(false);
+}
+
+bool JsonReader::closeOrSeparate(char close) {
+    if (pendingComma.empty()) fail("no open container");
+    skipWhitespace();
+    if (pos < text.size() && text[pos] == close) {
+        pos++;
+        pendingComma.pop_back();
+        return false;
+    }
+    if (pendingComma.back()) expect(',');
+    pendingComma.back() = true;
+    return true;
+}
+
+bool JsonReader::nextMember(std::string_view& key) {
+    if (!closeOrSeparate('}')) return false;
+    skipWhitespace();
+    if (pos >= text.size() || text[pos] != '"') fail("expected member name");
+    key = readString();
+    expect(':');
+    return true;
+}
+
+bool JsonReader::nextElement() {
+    return closeOrSeparate(']');
+}
+
+uint32_t JsonReader::readHex4() {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = next();
+        value <<= 4;
+        if (c >= '0' && c <= '9') value |= c - '0';
+        else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+        else fail("invalid \\u escape");
+    }
+    return value;
+}
+
+std::string_view JsonReader::readString() {
+    expect('"');
+    size_t start = pos;
+    // Fast path: no escapes, return a view into the document
+    while (pos < text.size() && text[pos] != '"' && text[pos] != '\\') {
+        if (static_cast<unsigned char>(text[pos]) < 0x20) fail("control character in string");
+        pos++;
+    }
+    if (pos >= text.size()) fail("unterminated string");
+    if (text[pos] == '"') {
+        return text.substr(start, pos++ - start);
+    }
+    
+    scratch.assign(text.data() + start, pos - start);
+    for (;;) {
+        char c = next();
+        if (c == '"') break;
+        if (static_cast<unsigned char>(c) < 0x20) fail("control character in string");
+        if (c != '\\') {
+            scratch.push_back(c);
+            continue;
+        }
+        switch (next()) {
+        case '"': scratch.push_back('"'); break;
+        case '\\': scratch.push_back('\\'); break;
+        case '/': scratch.push_back('/'); break;
+        case 'b': scratch.push_back('\b'); break;
+        case 'f': scratch.push_back('\f'); break;
+        case 'n': scratch.push_back('\n'); break;
+        case 'r': scratch.push_back('\r'); break;
+        case 't': scratch.push_back('\t'); break;
+        case 'u': {
+            uint32_t code = readHex4();
+            if (code >= 0xD800 && code < 0xDC00) {
+                expectWord("\\u");
+                uint32_t low = readHex4();
+                if (low < 0xDC00 || low >= 0xE000) fail("unpaired surrogate");
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            } else if (code >= 0xDC00 && code < 0xE000) {
+                fail("unpaired surrogate");
+            }
+            // UTF-8 encode
+            if (code < 0x80) {
+                scratch.push_back(static_cast<char>(code));
+            } else if (code < 0x800) {
+                scratch.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                scratch.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            } else if (code < 0x10000) {
+                scratch.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                scratch.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                scratch.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            } else {
+                scratch.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                scratch.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                scratch.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                scratch.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            break;
+        }
+        default:
+            fail("invalid escape");
+        }
+    }
+    return scratch;
+}
+
+double JsonReader::readNumber() {
+    skipWhitespace();
+    size_t start = pos;
+    auto digits = [&] {
+        size_t first = pos;
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') pos++;
+        if (pos == first) fail("expected digit");
+    };
+    if (pos < text.size() && text[pos] == '-') pos++;
+    if (pos < text.size() && text[pos] == '0') {
+        pos++;
+    } else {
+        digits();
+    }
+    if (pos < text.size() && text[pos] == '.') {
+        pos++;
+        digits();
+    }
+    if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+        pos++;
+        if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) pos++;
+        digits();
+    }
+    // The grammar was checked above, so strtod sees a well-formed, bounded token
+    std::string token(text.substr(start, pos - start));
+    return std::strtod(token.c_str(), nullptr);
+}
+
+bool JsonReader::readBoolean() {
+    skipWhitespace();
+    if (pos < text.size() && text[pos] == 't') {
+        expectWord("true");
+        return true;
+    }
+    expectWord("false");
+    return false;
+}
+
+void JsonReader::readNull() {
+    skipWhitespace();
+    expectWord("null");
+}
+
+void JsonReader::skipValue() {
+    std::string_view key;
+    switch (peek()) {
+    case Type::Object:
+        beginObject();
+        while (nextMember(key)) skipValue();
+        break;
+    case Type::Array:
+        beginArray();
+        while (nextElement()) skipValue();
+        break;
+    case Type::String: readString(); break;
+    case Type::Number: readNumber(); break;
+    case Type::Boolean: readBoolean(); break;
+    case Type::Null: readNull(); break;
+    case Type::End: fail("unexpected end of input");
+    }
+}
@@ -0,0 +1,204 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "KeywordMatcher.h"
+#include <algorithm>
+#include <cstring>
+#include <queue>
+
+namespace {
+
+unsigned char fold(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+}
+
+} // namespace
+
+KeywordMatcher::KeywordMatcher()
+    : classCount(1), emptyRule(npos), transitions(1, 0), output(1, npos), ruleStart(2, 0),
+      dictLink(1, 0) {
+    std::memset(byteClass, 0, sizeof(byteClass));
+    bindOwnedTables();
+}
+
+void KeywordMatcher::bindOwnedTables() {
+    table = transitions.data();
+    outputs = output.data();
+    ruleStarts = ruleStart.data();
+    ruleLists = ruleList.data();
+    dictLinks = dictLink.data();
+    states = static_cast<uint32_t>(output.size());
+}
+
+void KeywordMatcher::compile(const std::vector<std::vector<std::string>>& keywords) {
+    // Alphabet: class 0 for bytes that appear in no keyword, one class per folded byte used
+    std::memset(byteClass, 0, sizeof(byteClass));
+    classCount = 1;
+    for (const auto& rule : keywords) {
+        for (const auto& keyword : rule) {
+            for (unsigned char c : keyword) {
+                unsigned char f = fold(c);
+                if (byteClass[f] == 0) byteClass[f] = static_cast<uint8_t>(classCount++);
+            }
+        }
+    }
+    for (int c = 'A'; c <= 'Z'; ++c) byteClass[c] = byteClass[fold(static_cast<unsigned char>(c))];
+    
+    // Trie; 0 in a transition slot means "no edge" until failure links fill it in
+    emptyRule = npos;
+    transitions.assign(classCount, 0);
+    output.assign(1, npos);
+    std::vector<std::vector<uint32_t>> ends(1);
+    for (uint32_t rule = 0; rule < keywords.size(); ++rule) {
+        for (const auto& keyword : keywords[rule]) {
+            if (keyword.empty()) {
+                emptyRule = std::min(emptyRule, rule);
+                if (ends[0].empty() || ends[0].back() != rule) ends[0].push_back(rule);
+                continue;
+            }
+            uint32_t state = 0;
+            for (unsigned char c : keyword) {
+                uint32_t& next = transitions[state * classCount + byteClass[c]];
+                if (next == 0) {
+                    next = static_cast<uint32_t>(output.size());
+                    output.push_back(npos);
+                    ends.emplace_back();
+                    transitions.resize(transitions.size() + classCount, 0);
+                }
+                // resize may have moved the table; re-read through the index
+                state = transitions[state * classCount + byteClass[c]];
+            }
+            output[state] = std::min(output[state], rule);
+            if (ends[state].empty() || ends[state].back() != rule) ends[state].push_back(rule);
+        }
+    }
+    
+    // Breadth-first failure links, folded straight into a complete DFA
+    std::vector<uint32_t> fail(output.size(), 0);
+    dictLink.assign(output.size(), 0);
+    std::queue<uint32_t> queue;
+    for (uint32_t c = 0; c < classCount; ++c) {
+        uint32_t child = transitions[c];
+        if (child != 0) queue.push(child);
+    }
+    while (!queue.empty()) {
+        uint32_t state = queue.front();
+        queue.pop();
+        output[state] = std::min(output[state], output[fail[state]]);
+        // The root's (empty keyword) rules are reported once per text, not chained
+        uint32_t suffix = fail[state];
+        dictLink[state] = (suffix != 0 && !ends[suffix].empty()) ? suffix : dictLink[suffix];
+        for (uint32_t c = 0; c < classCount; ++c) {
+            uint32_t& next = transitions[state * classCount + c];
+            uint32_t fallback = transitions[fail[state] * classCount + c];
+            if (next == 0) {
+                next = fallback;
+            } else {
+                fail[next] = fallback;
+                queue.push(next);
+            }
+        }
+    }
+    
+    ruleStart.assign(1, 0);
+    ruleList.clear();
+    for (const auto& rules : ends) {
+        ruleList.insert(ruleList.end(), rules.begin(), rules.end());
+        ruleStart.push_back(static_cast<uint32_t>(ruleList.size()));
+    }
+    bindOwnedTables();
+}
+
+uint32_t KeywordMatcher::match(std::string_view text) const {
+    uint32_t best = emptyRule;
+    uint32_t state = 0;
+    for (unsigned char c : text) {
+        state = table[state * classCount + byteClass[c]];
+        best = std::min(best, outputs[state]);
+        if (best == 0) break;  // Nothing outranks the first rule
+    }
+    return best;
+}
+
+void KeywordMatcher::matchAll(std::string_view text, uint64_t* rules) const {
+    auto report = [&](uint32_t state) {
+        for (uint32_t i = ruleStarts[state]; i < ruleStarts[state + 1]; ++i) {
+            rules[ruleLists[i] >> 6] |= uint64_t(1) << (ruleLists[i] & 63);
+        }
+    };
+    report(0);
+    uint32_t state = 0;
+    for (unsigned char c : text) {
+        state = table[state * classCount + byteClass[c]];
+        for (uint32_t s = state; s != 0; s = dictLinks[s]) report(s);
+    }
+}
+
+void KeywordMatcher::serialize(std::vector<uint32_t>& out) const {
+    out.push_back(classCount);
+    out.push_back(emptyRule);
+    out.push_back(states);
+    for (size_t i = 0; i < sizeof(byteClass); i += 4) {
+        uint32_t word;
+        std::memcpy(&word, byteClass + i, sizeof(word));
+        out.push_back(word);
+    }
+    out.insert(out.end(), table, table + size_t(states) * classCount);
+    out.insert(out.end(), outputs, outputs + states);
+    out.insert(out.end(), ruleStarts, ruleStarts + states + 1);
+    out.insert(out.end(), ruleLists, ruleLists + ruleStarts[states]);
+    out.insert(out.end(), dictLinks, dictLinks + states);
+}
+
+size_t KeywordMatcher::attach(const uint32_t* words, size_t count, uint32_t ruleCount) {
+    const size_t header = 3 + sizeof(byteClass) / 4;
+    if (count < header) return 0;
+    uint32_t classes = words[0];
+    uint32_t stateTotal = words[2];
+    if (classes == 0 || classes > 256 || stateTotal == 0) return 0;
+    size_t needed = header + size_t(stateTotal) * classes + 2 * size_t(stateTotal) + 1;
+    if (count < needed) return 0;
+    
+    uint8_t classes8[256];
+    std::memcpy(classes8, words + 3, sizeof(classes8));
+    for (uint8_t c : classes8) {
+        if (c >= classes) return 0;
+    }
+    auto knownRule = [ruleCount](uint32_t rule) { return rule < ruleCount; };
+    auto knownState = [stateTotal](uint32_t state) { return state < stateTotal; };
+    auto validRule = [ruleCount](uint32_t rule) { return rule == npos || rule < ruleCount; };
+    
+    const uint32_t* tableWords = words + header;
+    if (!std::all_of(tableWords, tableWords + size_t(stateTotal) * classes, knownState)) return 0;
+    const uint32_t* outputWords = tableWords + size_t(stateTotal) * classes;
+    if (!validRule(words[1]) || !std::all_of(outputWords, outputWords + stateTotal, validRule)) {
+        return 0;
+    }
+    const uint32_t* startWords = outputWords + stateTotal;
+    if (startWords[0] != 0 || !std::is_sorted(startWords, startWords + stateTotal + 1)) return 0;
+    size_t listSize = startWords[stateTotal];
+    if (count - needed < listSize + stateTotal) return 0;
+    const uint32_t* listWords = startWords + stateTotal + 1;
+    const uint32_t* linkWords = listWords + listSize;
+    if (!std::all_of(listWords, listWords + listSize, knownRule)) return 0;
+    // Bounds only: the caller is expected to checksum the words (a link cycle would not
+    // read out of bounds, but matchAll would not terminate)
+    if (!std::all_of(linkWords, linkWords + stateTotal, knownState)) return 0;
+    needed += listSize + stateTotal;
+    
+    std::memcpy(byteClass, classes8, sizeof(byteClass));
+    classCount = classes;
+    emptyRule = words[1];
+    transitions.clear();
+    output.clear();
+    ruleStart.clear();
+    ruleList.clear();
+    dictLink.clear();
+    table = tableWords;
+    outputs = outputWords;
+    ruleStarts = startWords;
+    ruleLists = listWords;
+    dictLinks = linkWords;
+    states = stateTotal;
+    return needed;
+}
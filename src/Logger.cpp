@@ -2,15 +2,18 @@
 #include "Logger.h"
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include <mutex>
 
 namespace mt {
 void Logger::init() {
-    static bool initialized = false;
-    if (initialized) return;
-    auto logger = spdlog::stdout_color_mt("moneytracker");
-    spdlog::set_default_logger(logger);
-    spdlog::set_level(spdlog::level::info);
-    initialized = true;
+    // Logging can start on any thread (e.g. the category watcher), and registering the
+    // logger twice throws
+    static std::once_flag initialized;
+    std::call_once(initialized, []() {
+        auto logger = spdlog::stdout_color_mt("moneytracker");
+        spdlog::set_default_logger(logger);
+        spdlog::set_level(spdlog::level::info);
+    });
 }
 
 void Logger::info(const std::string& msg) { init(); spdlog::info("{}", msg); }
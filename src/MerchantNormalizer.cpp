@@ -0,0 +1,188 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "MerchantNormalizer.h"
+#include "CSVParser.h"
+#include <algorithm>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+// Processors that print their own name ahead of a '*' and the merchant after it
+const char* const kProcessors[] = {"sq", "tst", "sp", "py", "pp", "paypal", "dd", "ic", "in",
+                                   "google", "fs"};
+
+// Transaction-type words banks put ahead of the merchant
+const char* const kLeadingNoise[] = {"pos", "debit", "purchase", "checkcard", "recurring",
+                                     "card"};
+
+// US state and territory codes (plus the country) that end card descriptors
+const char* const kRegions[] = {
+    "al", "ak", "az", "ar", "ca", "co", "ct", "de", "fl", "ga", "hi", "id", "il", "in",
+    "ia", "ks", "ky", "la", "me", "md", "ma", "mi", "mn", "ms", "mo", "mt", "ne", "nv",
+    "nh", "nj", "nm", "ny", "nc", "nd", "oh", "ok", "or", "pa", "ri", "sc", "sd", "tn",
+    "tx", "ut", "vt", "va", "wa", "wv", "wi", "wy", "dc", "pr", "us"};
+
+template <size_t N>
+bool inList(std::string_view word, const char* const (&list)[N]) {
+    return std::find(std::begin(list), std::end(list), word) != std::end(list);
+}
+
+bool isLetter(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '&' || c == '\'' ||
+           c >= 0x80;
+}
+
+bool isDigit(unsigned char c) {
+    return c >= '0' && c <= '9';
+}
+
+enum class State { Gap, Token };
+
+// Byte-level state machine: Gap between tokens, Token inside a run of letters and digits.
+// Kept words go straight to `out`; `breaks` records where in `out` a dropped code or a wide
+// gap separated words, which later bounds the city in front of a state code.
+class Normalizer {
+public:
+    explicit Normalizer(std::string_view description) {
+        out.reserve(description.size());
+        State state = State::Gap;
+        int spaces = 0;
+        for (unsigned char c : description) {
+            bool letter = isLetter(c);
+            bool digit = isDigit(c);
+            switch (state) {
+            case State::Gap:
+                if (letter || digit) {
+                    if (spaces >= 2) markBreak();
+                    state = State::Token;
+                    startToken();
+                    consume(c, digit);
+                } else if (c == ' ' || c == '\t') {
+                    spaces++;
+                } else {
+                    if (c == '*') stripProcessor();
+                    spaces = 0;
+                }
+                break;
+            case State::Token:
+                if (letter || digit) {
+                    consume(c, digit);
+                } else {
+                    finishToken();
+                    state = State::Gap;
+                    spaces = (c == ' ' || c == '\t') ? 1 : 0;
+                    if (c == '*') stripProcessor();
+                }
+                break;
+            }
+        }
+        if (state == State::Token) finishToken();
+        stripRegion();
+    }
+
+    std::string take() { return std::move(out); }
+
+private:
+    std::string out;
+    std::vector<size_t> wordStarts;
+    std::vector<size_t> breaks;
+
+    // Current token, lowercased, with its digit runs
+    std::string token;
+    int digitRuns = 0;
+    bool lastWasDigit = false;
+    bool startsWithDigit = false;
+
+    void startToken() {
+        token.clear();
+        digitRuns = 0;
+        lastWasDigit = false;
+        startsWithDigit = false;
+    }
+
+    void consume(unsigned char c, bool digit) {
+        if (digit) {
+            if (!lastWasDigit) digitRuns++;
+            if (token.empty()) startsWithDigit = true;
+        }
+        lastWasDigit = digit;
+        token.push_back(static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c));
+    }
+
+    void markBreak() {
+        if (!wordStarts.empty()) breaks.push_back(out.size());
+    }
+
+    void finishToken() {
+        if (digitRuns > 0) {
+            // One digit run on the edge of a long word belongs to the name ("7ELEVEN"); any
+            // other token with digits is a store number, date or reference code. Only runs
+            // matter, not their length or value.
+            bool edge = digitRuns == 1 && (startsWithDigit || lastWasDigit);
+            token.erase(std::remove_if(token.begin(), token.end(),
+                                       [](char c) { return isDigit(c); }),
+                        token.end());
+            if (!edge || token.size() < 4) {
+                markBreak();
+                return;
+            }
+        }
+        if (token.size() >= 3 && token.find_first_not_of('x') == std::string::npos) {
+            markBreak();  // Masked card number
+            return;
+        }
+        if (wordStarts.empty() && inList(token, kLeadingNoise)) return;
+
+        if (!out.empty()) out.push_back(' ');
+        wordStarts.push_back(out.size());
+        out += token;
+    }
+
+    // "SQ *MERCHANT": everything so far named the processor
+    void stripProcessor() {
+        if (!inList(out, kProcessors)) return;
+        out.clear();
+        wordStarts.clear();
+        breaks.clear();
+    }
+
+    // "NAME 0423 CITY ST": drop the state and, when a store number or wide gap marks where
+    // the name ends, the city as well
+    void stripRegion() {
+        if (wordStarts.size() < 2) return;
+        size_t last = wordStarts.back();
+        if (!inList(std::string_view(out).substr(last), kRegions)) return;
+
+        size_t cut = 0;
+        for (size_t b : breaks) {
+            if (b < last) cut = std::max(cut, b);
+        }
+        if (cut > 0) {
+            out.resize(cut);
+        } else if (wordStarts.size() >= 3) {
+            out.resize(last - 1);
+        }
+    }
+};
+
+} // namespace
+
+std::string normalizeMerchant(std::string_view description) {
+    return Normalizer(description).take();
+}
+
+const std::string& internMerchant(std::string_view key) {
+    // Node-based set: elements never move, so references handed out stay valid
+    static std::mutex mutex;
+    static std::unordered_set<std::string> pool;
+    std::lock_guard<std::mutex> lock(mutex);
+    return *pool.emplace(key).first;
+}
+
+const std::string& merchantKey(const Transaction& transaction) {
+    if (transaction.merchant) return *transaction.merchant;
+    return internMerchant(normalizeMerchant(transaction.description));
+}
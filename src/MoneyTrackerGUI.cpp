@@ -9,11 +9,30 @@
 #include <sstream>
 #include <iomanip>
 
+namespace {
+
+struct ReloadEvent {
+    MoneyTrackerGUI* gui;
+    bool loaded;
+    std::string message;
+    CategoryConfig previous;
+};
+
+} // namespace
+
 MoneyTrackerGUI::MoneyTrackerGUI()
     : window(nullptr), transaction_data(std::make_shared<TransactionData>()),
       config_manager(std::make_shared<ConfigManager>()) {
     
     config_manager->loadCategoriesFromFile("data/categories.json");
+    // Pick up edits to the rules without restarting the session. The callback runs on the
+    // watcher thread, so hand the result to the GTK main loop before touching any state.
+    config_manager->setReloadCallback(
+        [this](bool loaded, const std::string& message, const CategoryConfig& previous) {
+            auto* reload = new ReloadEvent{this, loaded, message, previous};
+            g_idle_add(&MoneyTrackerGUI::on_rules_reloaded, reload);
+        });
+    config_manager->watchCategoriesFile("data/categories.json");
 }
 
 MoneyTrackerGUI::~MoneyTrackerGUI() {
@@ -449,6 +468,7 @@ void MoneyTrackerGUI::run_analysis() {
         // Load configuration
         const char* config_path = gtk_entry_get_text(GTK_ENTRY(category_config_entry));
         config_manager->loadCategoriesFromFile(config_path);
+        config_manager->watchCategoriesFile(config_path);
         
         gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progress_bar), 0.5);
         
@@ -477,6 +497,29 @@ void MoneyTrackerGUI::run_analysis() {
     }
 }
 
+gboolean MoneyTrackerGUI::on_rules_reloaded(gpointer data) {
+    std::unique_ptr<ReloadEvent> reload(static_cast<ReloadEvent*>(data));
+    reload->gui->apply_reloaded_rules(reload->loaded, reload->message, reload->previous);
+    return G_SOURCE_REMOVE;
+}
+
+void MoneyTrackerGUI::apply_reloaded_rules(bool loaded, const std::string& message,
+                                           const CategoryConfig& previous) {
+    if (!loaded) {
+        mt::Logger::warn(message);
+        return;
+    }
+    mt::Logger::info(message);
+    if (transaction_data->getAllTransactions().empty()) return;
+    
+    // Only rows the changed keywords can reach are re-evaluated
+    size_t changed = transaction_data->recategorize(*config_manager, previous);
+    if (changed > 0) {
+        mt::Logger::info("Recategorized " + std::to_string(changed) + " transaction(s)");
+        display_results();
+    }
+}
+
 void MoneyTrackerGUI::display_results() {
     BudgetAnalyzer analyzer(*transaction_data);
     BudgetSummary summary = analyzer.analyzeBudget();
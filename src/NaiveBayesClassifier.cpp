@@ -0,0 +1,275 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "NaiveBayesClassifier.h"
+#include "ConfigManager.h"
+#include "Hashing.h"
+#include "MappedFile.h"
+#include "Parallel.h"
+#include "TransactionData.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t kModelMagic = 0x424E544D;  // "MTNB"
+constexpr uint32_t kModelVersion = 1;
+constexpr size_t kModelHeader = 6;  // magic, version, bits, categories, payload hash
+constexpr float kSmoothing = 0.1f;
+constexpr float kPadding = -1e30f;  // Score of the padding columns
+
+// Calls visit(bucket) for every token and adjacent-token pair of text. Tokens are hashed
+// byte by byte as they are scanned, so no strings are built.
+template <typename Visit>
+void forEachFeature(std::string_view text, uint32_t bits, Visit visit) {
+    const uint64_t kBasis = 0xcbf29ce484222325ULL;
+    const uint64_t kPrime = 0x100000001b3ULL;
+    int shift = 64 - static_cast<int>(bits);
+    uint64_t h = kBasis;
+    uint64_t previous = 0;
+    bool inToken = false, hasDigit = false, hasPrevious = false;
+
+    auto finish = [&]() {
+        if (inToken && !hasDigit) {
+            uint64_t token = mt::mixHash(h);
+            visit(static_cast<uint32_t>(token >> shift));
+            if (hasPrevious) {
+                visit(static_cast<uint32_t>(mt::combineHash(previous, token) >> shift));
+            }
+            previous = token;
+            hasPrevious = true;
+        }
+        h = kBasis;
+        inToken = hasDigit = false;
+    };
+
+    for (unsigned char c : text) {
+        if ((c >= 'a' && c <= 'z') || c >= 0x80) {
+            h = (h ^ c) * kPrime;
+            inToken = true;
+        } else if (c >= 'A' && c <= 'Z') {
+            h = (h ^ static_cast<unsigned char>(c - 'A' + 'a')) * kPrime;
+            inToken = true;
+        } else if (c >= '0' && c <= '9') {
+            hasDigit = inToken = true;
+        } else {
+            finish();
+        }
+    }
+    finish();
+}
+
+void putString(std::vector<uint32_t>& words, const std::string& s) {
+    words.push_back(static_cast<uint32_t>(s.size()));
+    size_t start = words.size();
+    words.resize(start + (s.size() + 3) / 4, 0);
+    std::memcpy(words.data() + start, s.data(), s.size());
+}
+
+void putFloat(std::vector<uint32_t>& words, float value) {
+    uint32_t word;
+    std::memcpy(&word, &value, sizeof(word));
+    words.push_back(word);
+}
+
+} // namespace
+
+NaiveBayesClassifier::NaiveBayesClassifier(uint32_t bits)
+    : bits(bits), stride(0), confidence(kDefaultConfidence) {
+    if (bits < 8 || bits > 24) {
+        throw std::invalid_argument("Feature table bits must be between 8 and 24");
+    }
+}
+
+void NaiveBayesClassifier::resize(size_t categoryCount) {
+    stride = (categoryCount + 7) / 8 * 8;
+    priors.assign(stride, kPadding);
+    weights.assign((size_t(1) << bits) * stride, 0.0f);
+}
+
+size_t NaiveBayesClassifier::train(const TransactionData& data,
+                                   const std::string& uncategorized) {
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint32_t> ids;
+    std::vector<uint32_t> rowCategory;
+    std::vector<const Transaction*> rows;
+    for (const auto& t : data.getAllTransactions()) {
+        if (t.category.empty() || t.category == uncategorized) continue;
+        auto inserted = ids.emplace(t.category, static_cast<uint32_t>(names.size()));
+        if (inserted.second) names.push_back(t.category);
+        rowCategory.push_back(inserted.first->second);
+        rows.push_back(&t);
+    }
+    if (names.size() < 2) {
+        categories.clear();
+        resize(0);
+        return 0;
+    }
+
+    size_t buckets = size_t(1) << bits;
+    std::vector<float> counts(buckets * names.size(), 0.0f);
+    std::vector<double> totals(names.size(), 0.0);
+    std::vector<double> documents(names.size(), 0.0);
+    for (size_t r = 0; r < rows.size(); ++r) {
+        uint32_t c = rowCategory[r];
+        documents[c] += 1.0;
+        forEachFeature(rows[r]->description, bits, [&](uint32_t bucket) {
+            counts[bucket * names.size() + c] += 1.0f;
+            totals[c] += 1.0;
+        });
+    }
+
+    categories = std::move(names);
+    resize(categories.size());
+    for (size_t c = 0; c < categories.size(); ++c) {
+        priors[c] = static_cast<float>(std::log(documents[c] / rows.size()));
+        float norm = static_cast<float>(std::log(totals[c] + kSmoothing * buckets));
+        for (size_t b = 0; b < buckets; ++b) {
+            weights[b * stride + c] =
+                std::log(counts[b * categories.size() + c] + kSmoothing) - norm;
+        }
+    }
+    return rows.size();
+}
+
+void NaiveBayesClassifier::save(const std::string& filePath) const {
+    // Header: magic, version, bits, category count, payload hash (2 words). Payload: category
+    // names (length, padded bytes), then priors and the bucket-major table without padding.
+    std::vector<uint32_t> words = {kModelMagic, kModelVersion, bits,
+                                   static_cast<uint32_t>(categories.size()), 0, 0};
+    for (const auto& name : categories) putString(words, name);
+    size_t buckets = size_t(1) << bits;
+    words.reserve(words.size() + (buckets + 1) * categories.size());
+    for (size_t c = 0; c < categories.size(); ++c) putFloat(words, priors[c]);
+    for (size_t b = 0; b < buckets; ++b) {
+        for (size_t c = 0; c < categories.size(); ++c) putFloat(words, weights[b * stride + c]);
+    }
+    uint64_t hash = mt::hashBytes(std::string_view(
+        reinterpret_cast<const char*>(words.data() + kModelHeader),
+        (words.size() - kModelHeader) * 4));
+    words[4] = static_cast<uint32_t>(hash);
+    words[5] = static_cast<uint32_t>(hash >> 32);
+
+    std::string tempPath = filePath + ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(words.data()),
+                  static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+        if (!out.good()) {
+            out.close();
+            std::remove(tempPath.c_str());
+            throw std::runtime_error("Cannot write category model: " + filePath);
+        }
+    }
+    if (std::rename(tempPath.c_str(), filePath.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        throw std::runtime_error("Cannot write category model: " + filePath);
+    }
+}
+
+bool NaiveBayesClassifier::load(const std::string& filePath) {
+    MappedFile mapping;
+    if (!mapping.open(filePath) || mapping.size() % 4 != 0) return false;
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(mapping.data());
+    size_t count = mapping.size() / 4;
+    if (count < kModelHeader || words[0] != kModelMagic || words[1] != kModelVersion ||
+        words[2] != bits) {
+        return false;
+    }
+    std::string_view payload(reinterpret_cast<const char*>(words + kModelHeader),
+                             (count - kModelHeader) * 4);
+    uint64_t hash = static_cast<uint64_t>(words[5]) << 32 | words[4];
+    if (mt::hashBytes(payload) != hash) return false;
+
+    size_t categoryCount = words[3];
+    if (categoryCount < 2) return false;
+    size_t pos = kModelHeader;
+    std::vector<std::string> names;
+    for (size_t c = 0; c < categoryCount; ++c) {
+        if (pos >= count) return false;
+        size_t length = words[pos++];
+        size_t padded = (length + 3) / 4;
+        if (padded > count - pos) return false;
+        names.emplace_back(reinterpret_cast<const char*>(words + pos), length);
+        pos += padded;
+    }
+    size_t buckets = size_t(1) << bits;
+    if (count - pos != (buckets + 1) * categoryCount) return false;
+
+    categories = std::move(names);
+    resize(categoryCount);
+    const float* values = reinterpret_cast<const float*>(words + pos);
+    std::copy(values, values + categoryCount, priors.begin());
+    values += categoryCount;
+    for (size_t b = 0; b < buckets; ++b) {
+        std::copy(values + b * categoryCount, values + (b + 1) * categoryCount,
+                  weights.begin() + b * stride);
+    }
+    return true;
+}
+
+void NaiveBayesClassifier::classifyBatch(const std::string_view* descriptions, size_t count,
+                                         uint32_t* best, float* probability) const {
+    if (!isTrained()) {
+        std::fill(best, best + count, npos);
+        std::fill(probability, probability + count, 0.0f);
+        return;
+    }
+    std::vector<float> scores(stride);
+    const size_t width = stride;
+    for (size_t i = 0; i < count; ++i) {
+        std::copy(priors.begin(), priors.end(), scores.begin());
+        float* score = scores.data();
+        forEachFeature(descriptions[i], bits, [&](uint32_t bucket) {
+            const float* row = weights.data() + bucket * width;
+            for (size_t c = 0; c < width; ++c) score[c] += row[c];
+        });
+
+        size_t top = std::max_element(scores.begin(), scores.end()) - scores.begin();
+        // Posterior of the winner: 1 / sum(exp(score - top)); far-behind terms are skipped
+        float sum = 0.0f;
+        for (size_t c = 0; c < categories.size(); ++c) {
+            float delta = score[c] - score[top];
+            if (delta > -30.0f) sum += std::exp(delta);
+        }
+        best[i] = static_cast<uint32_t>(top);
+        probability[i] = 1.0f / sum;
+    }
+}
+
+std::string NaiveBayesClassifier::classify(std::string_view description) const {
+    uint32_t best;
+    float probability;
+    classifyBatch(&description, 1, &best, &probability);
+    return best != npos && probability >= confidence ? categories[best] : std::string();
+}
+
+std::vector<std::string> NaiveBayesClassifier::suggest(
+    const std::vector<const Transaction*>& rows) const {
+    std::vector<std::string_view> descriptions(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) descriptions[i] = rows[i]->description;
+    std::vector<uint32_t> best(rows.size());
+    std::vector<float> probability(rows.size());
+    auto run = [&](size_t begin, size_t end) {
+        classifyBatch(descriptions.data() + begin, end - begin, best.data() + begin,
+                      probability.data() + begin);
+    };
+    if (rows.size() < ConfigManager::kParallelBatch) {
+        run(0, rows.size());
+    } else {
+        mt::parallelFor(rows.size(), ConfigManager::kParallelBatch / 4, run);
+    }
+
+    std::vector<std::string> result(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (best[i] != npos && probability[i] >= confidence) result[i] = categories[best[i]];
+    }
+    return result;
+}
@@ -0,0 +1,170 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace mt {
+namespace {
+
+class ThreadPool {
+public:
+    static ThreadPool& instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    size_t size() const { return threadCount; }
+
+    void submit(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(std::move(job));
+        }
+        available.notify_one();
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+private:
+    ThreadPool() : threadCount(std::max(1u, std::thread::hardware_concurrency())) {
+        // The caller of parallelInvoke always works too, so one thread fewer is enough
+        for (size_t i = 1; i < threadCount; ++i) {
+            workers.emplace_back([this]() { run(); });
+        }
+    }
+
+    void run() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                available.wait(lock, [this]() { return stopping || !jobs.empty(); });
+                if (stopping && jobs.empty()) return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    size_t threadCount;
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping = false;
+};
+
+// Shared between the caller and helper jobs; helpers that start after all tasks were
+// claimed only touch this state, never the caller's stack.
+struct InvokeState {
+    const std::function<void(size_t)>* task = nullptr;
+    size_t tasks = 0;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+
+    void work() {
+        for (size_t i = next++; i < tasks; i = next++) {
+            try {
+                (*task)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+            }
+            if (++done == tasks) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+};
+
+} // namespace
+
+size_t workerCount() {
+    return ThreadPool::instance().size();
+}
+
+std::vector<std::pair<size_t, size_t>> partition(size_t count, size_t minChunk) {
+    size_t bySize = count / std::max<size_t>(1, minChunk);
+    size_t chunks = std::max<size_t>(1, std::min(workerCount(), bySize));
+    std::vector<std::pair<size_t, size_t>> ranges;
+    ranges.reserve(chunks);
+    for (size_t c = 0; c < chunks; ++c) {
+        ranges.emplace_back(count * c / chunks, count * (c + 1) / chunks);
+    }
+    return ranges;
+}
+
+void parallelInvoke(size_t tasks, const std::function<void(size_t)>& task) {
+    if (tasks == 0) return;
+    if (tasks == 1 || workerCount() == 1) {
+        for (size_t i = 0; i < tasks; ++i) task(i);
+        return;
+    }
+
+    auto state = std::make_shared<InvokeState>();
+    state->task = &task;
+    state->tasks = tasks;
+
+    size_t helpers = std::min(tasks, workerCount()) - 1;
+    for (size_t h = 0; h < helpers; ++h) {
+        ThreadPool::instance().submit([state]() { state->work(); });
+    }
+    state->work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state]() { return state->done == state->tasks; });
+    if (state->error) std::rethrow_exception(state->error);
+}
+
+void parallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)>& fn) {
+    auto ranges = partition(count, minChunk);
+    parallelInvoke(ranges.size(), [&](size_t c) { fn(ranges[c].first, ranges[c].second); });
+}
+
+void parallelInclusiveScan(double* values, size_t count, size_t minChunk) {
+    auto ranges = partition(count, minChunk);
+    if (ranges.size() == 1) {
+        for (size_t i = 1; i < count; ++i) values[i] += values[i - 1];
+        return;
+    }
+
+    std::vector<double> offsets(ranges.size(), 0.0);
+    parallelInvoke(ranges.size(), [&](size_t c) {
+        for (size_t i = ranges[c].first + 1; i < ranges[c].second; ++i) {
+            values[i] += values[i - 1];
+        }
+    });
+    for (size_t c = 1; c < ranges.size(); ++c) {
+        offsets[c] = offsets[c - 1] + values[ranges[c - 1].second - 1];
+    }
+    parallelInvoke(ranges.size() - 1, [&](size_t c) {
+        double offset = offsets[c + 1];
+        for (size_t i = ranges[c + 1].first; i < ranges[c + 1].second; ++i) {
+            values[i] += offset;
+        }
+    });
+}
+
+} // namespace mt
@@ -0,0 +1,97 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+QuantileSketch::QuantileSketch(uint32_t k) : k(std::max<uint32_t>(k, 8)), n(0), retained(0), coin(false) {
+    levels.emplace_back();
+    budget = totalCapacity();
+}
+
+size_t QuantileSketch::capacity(size_t level) const {
+    // Capacities shrink geometrically (factor 2/3) below the top level
+    size_t depth = levels.size() - 1 - level;
+    double cap = std::ceil(k * std::pow(2.0 / 3.0, static_cast<double>(depth)));
+    return std::max<size_t>(2, static_cast<size_t>(cap));
+}
+
+void QuantileSketch::add(double value) {
+    levels[0].push_back(value);
+    ++n;
+    ++retained;
+    compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.levels.size() > levels.size()) {
+        levels.resize(other.levels.size());
+        budget = totalCapacity();
+    }
+    for (size_t h = 0; h < other.levels.size(); ++h) {
+        levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+    }
+    n += other.n;
+    retained += other.retained;
+    compress();
+}
+
+size_t QuantileSketch::totalCapacity() const {
+    size_t total = 0;
+    for (size_t h = 0; h < levels.size(); ++h) {
+        total += capacity(h);
+    }
+    return total;
+}
+
+void QuantileSketch::compress() {
+    // Compact the lowest over-full level until the sketch fits its overall budget
+    while (retained >= budget) {
+        size_t h = 0;
+        while (levels[h].size() < capacity(h)) ++h;
+        if (h + 1 == levels.size()) {
+            levels.emplace_back();
+            budget = totalCapacity();
+        }
+
+        auto& level = levels[h];
+        std::sort(level.begin(), level.end());
+
+        // With an odd count the smallest item stays behind so weights remain exact
+        size_t keep = level.size() % 2;
+        size_t offset = coin ? 1 : 0;
+        coin = !coin;
+        for (size_t i = keep + offset; i < level.size(); i += 2) {
+            levels[h + 1].push_back(level[i]);
+        }
+        retained -= (level.size() - keep) / 2;
+        level.resize(keep);
+    }
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (n == 0) return 0.0;
+    q = std::min(1.0, std::max(0.0, q));
+
+    std::vector<std::pair<double, uint64_t>> weighted;
+    weighted.reserve(retainedItems());
+    for (size_t h = 0; h < levels.size(); ++h) {
+        for (double v : levels[h]) {
+            weighted.emplace_back(v, uint64_t(1) << h);
+        }
+    }
+    std::sort(weighted.begin(), weighted.end());
+
+    double target = q * static_cast<double>(n);
+    uint64_t cumulative = 0;
+    for (const auto& item : weighted) {
+        cumulative += item.second;
+        if (static_cast<double>(cumulative) >= target) {
+            return item.first;
+        }
+    }
+    return weighted.back().first;
+}
+
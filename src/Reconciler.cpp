@@ -0,0 +1,185 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "Reconciler.h"
+#include "CurrencyConverter.h"
+#include "DateParser.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+// Values per parallel scan chunk; shorter accounts are scanned serially
+const size_t kScanChunk = 1 << 16;
+
+struct Row {
+    int day;
+    size_t index;
+};
+
+bool sameCharge(const Transaction& a, const Transaction& b) {
+    return a.date == b.date && std::abs(a.statementAmount() - b.statementAmount()) < 0.005 &&
+           a.description == b.description;
+}
+
+} // namespace
+
+Reconciler::Reconciler(double tolerance, int statementGapDays)
+    : tolerance(std::max(0.0, tolerance)), statementGapDays(std::max(1, statementGapDays)) {}
+
+std::string Reconciler::issueName(ReconciliationIssue issue) {
+    switch (issue) {
+        case ReconciliationIssue::BalanceGap:
+            return "Balance gap";
+        case ReconciliationIssue::Duplicate:
+            return "Duplicate";
+        case ReconciliationIssue::MissingStatement:
+            return "Missing statement";
+    }
+    return "Unknown";
+}
+
+std::vector<AccountReconciliation> Reconciler::reconcile(const TransactionData& data) const {
+    const auto& transactions = data.getAllTransactions();
+    
+    // Group dated rows by account
+    std::unordered_map<std::string, size_t> accountIndex;
+    std::vector<AccountReconciliation> result;
+    std::vector<std::vector<Row>> rows;
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        int day;
+        try {
+            day = DateParser::toDayNumber(transactions[i].date);
+        } catch (const std::invalid_argument&) {
+            continue;
+        }
+        const std::string& account = transactions[i].accountName;
+        auto it = accountIndex.find(account);
+        if (it == accountIndex.end()) {
+            it = accountIndex.emplace(account, result.size()).first;
+            result.emplace_back();
+            result.back().accountName = account;
+            rows.emplace_back();
+        }
+        rows[it->second].push_back({day, i});
+    }
+    
+    mt::parallelInvoke(result.size(), [&](size_t a) {
+        AccountReconciliation& account = result[a];
+        std::vector<Row>& order = rows[a];
+        std::stable_sort(order.begin(), order.end(),
+                         [](const Row& x, const Row& y) { return x.day < y.day; });
+        
+        size_t n = order.size();
+        std::vector<double> running(n);
+        // Balances are reported in the statement currency, so scan the unconverted amounts
+        for (size_t i = 0; i < n; ++i) {
+            running[i] = transactions[order[i].index].statementAmount();
+        }
+        mt::parallelInclusiveScan(running.data(), n, kScanChunk);
+        
+        account.transactions = n;
+        account.currency =
+            CurrencyConverter::normalizeCode(transactions[order.front().index].currency);
+        account.firstDate = transactions[order.front().index].date;
+        account.lastDate = transactions[order.back().index].date;
+        
+        // offset = reported - computed; it stays constant while the statement and the
+        // imported rows agree, so any jump marks missing or extra activity on that row
+        bool anchored = false;
+        double offset = 0.0;
+        double lastReported = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            const Transaction& t = transactions[order[i].index];
+            bool duplicate = false;
+            
+            if (i > 0) {
+                const Transaction& previous = transactions[order[i - 1].index];
+                int gap = order[i].day - order[i - 1].day;
+                if (gap > statementGapDays) {
+                    account.flags.push_back({ReconciliationIssue::MissingStatement, t.date,
+                                             "No activity since " + previous.date, 0.0, gap});
+                }
+                bool unchanged = !t.hasBalance || !previous.hasBalance ||
+                                 std::abs(t.balance - previous.balance) <= tolerance;
+                duplicate = sameCharge(t, previous) && unchanged;
+                if (duplicate) {
+                    account.flags.push_back({ReconciliationIssue::Duplicate, t.date,
+                                             t.description, t.statementAmount(), 0});
+                }
+            }
+            
+            if (!t.hasBalance) continue;
+            double current = t.balance - running[i];
+            if (!anchored) {
+                anchored = true;
+                account.hasBalances = true;
+                account.openingBalance = current;
+            } else if (!duplicate && std::abs(current - offset) > tolerance) {
+                account.flags.push_back({ReconciliationIssue::BalanceGap, t.date, t.description,
+                                         current - offset, 0});
+            }
+            offset = current;
+            lastReported = t.balance;
+        }
+        
+        bool lastReportedRow = transactions[order.back().index].hasBalance;
+        account.closingBalance = lastReportedRow ? lastReported : offset + running.back();
+    });
+    
+    std::sort(result.begin(), result.end(), [](const auto& x, const auto& y) {
+        return x.accountName < y.accountName;
+    });
+    return result;
+}
+
+std::vector<CashFlowProjection>
+Reconciler::projectCashFlow(const std::vector<AccountReconciliation>& accounts,
+                            const std::vector<RecurringSeries>& recurring, int days) const {
+    std::vector<CashFlowProjection> result(accounts.size());
+    
+    mt::parallelInvoke(accounts.size(), [&](size_t a) {
+        const AccountReconciliation& account = accounts[a];
+        CashFlowProjection& projection = result[a];
+        projection.accountName = account.accountName;
+        projection.currency = account.currency;
+        projection.startingBalance = account.closingBalance;
+        projection.lowestBalance = account.closingBalance;
+        projection.lowestDate = account.lastDate;
+        if (account.lastDate.empty()) return;
+        
+        int horizon = DateParser::toDayNumber(account.lastDate) + days;
+        std::vector<Row> order;
+        std::vector<CashFlowPoint> events;
+        for (const auto& series : recurring) {
+            if (!series.active || series.accountName != account.accountName) continue;
+            for (std::string date = series.nextExpectedDate;
+                 DateParser::toDayNumber(date) <= horizon;
+                 date = RecurringDetector::nextDate(date, series.period)) {
+                order.push_back({DateParser::toDayNumber(date), events.size()});
+                events.push_back({date, series.merchant, series.nextStatementAmount, 0.0});
+            }
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [](const Row& x, const Row& y) { return x.day < y.day; });
+        
+        std::vector<double> running(order.size());
+        for (size_t i = 0; i < order.size(); ++i) running[i] = events[order[i].index].amount;
+        mt::parallelInclusiveScan(running.data(), running.size(), kScanChunk);
+        
+        projection.points.reserve(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            CashFlowPoint point = events[order[i].index];
+            point.balance = account.closingBalance + running[i];
+            if (point.balance < projection.lowestBalance) {
+                projection.lowestBalance = point.balance;
+                projection.lowestDate = point.date;
+            }
+            projection.points.push_back(std::move(point));
+        }
+    });
+    return result;
+}
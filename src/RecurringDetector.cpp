@@ -0,0 +1,204 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "RecurringDetector.h"
+#include "DateParser.h"
+#include "Hashing.h"
+#include "MerchantNormalizer.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+struct Entry {
+    uint64_t key;      // (merchant, account, sign)
+    double magnitude;  // log |amount|
+    int day;
+    uint32_t index;
+};
+
+struct PeriodRule {
+    RecurrencePeriod period;
+    int nominalDays;
+    int minDays;
+    int maxDays;
+    int slack;  // Allowed deviation of an individual interval from the median
+};
+
+const PeriodRule kPeriodRules[] = {
+    {RecurrencePeriod::Weekly, 7, 6, 8, 1},
+    {RecurrencePeriod::Monthly, 30, 27, 32, 4},
+    {RecurrencePeriod::Annual, 365, 358, 372, 7},
+};
+
+// Share of intervals that must sit near the median for a group to count as periodic
+const double kMinRegularity = 0.75;
+
+int daysInMonth(int year, int month) {
+    static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+    return (month == 2 && leap) ? 29 : days[month - 1];
+}
+
+} // namespace
+
+RecurringDetector::RecurringDetector(size_t minOccurrences, double amountTolerance)
+    : minOccurrences(std::max<size_t>(2, minOccurrences)),
+      amountTolerance(std::max(0.01, amountTolerance)) {}
+
+std::string RecurringDetector::nextDate(const std::string& last, RecurrencePeriod period) {
+    int day = DateParser::toDayNumber(last);
+    if (period == RecurrencePeriod::Weekly) {
+        return DateParser::fromDayNumber(day + 7);
+    }
+
+    int y = std::stoi(last.substr(0, 4));
+    int m = std::stoi(last.substr(5, 2));
+    int d = std::stoi(last.substr(8, 2));
+    if (period == RecurrencePeriod::Monthly) {
+        m = m == 12 ? 1 : m + 1;
+        y = m == 1 ? y + 1 : y;
+    } else {
+        y++;
+    }
+    d = std::min(d, daysInMonth(y, m));
+
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", y, m, d);
+    return std::string(buffer);
+}
+
+std::string RecurringDetector::periodName(RecurrencePeriod period) {
+    switch (period) {
+        case RecurrencePeriod::Weekly:
+            return "Weekly";
+        case RecurrencePeriod::Monthly:
+            return "Monthly";
+        case RecurrencePeriod::Annual:
+            return "Annual";
+    }
+    return "Unknown";
+}
+
+std::vector<RecurringSeries> RecurringDetector::detect(const TransactionData& data,
+                                                       const std::vector<bool>& excluded) const {
+    const auto& transactions = data.getAllTransactions();
+    double bandWidth = std::log1p(amountTolerance);
+
+    std::vector<Entry> entries;
+    entries.reserve(transactions.size());
+    int newestDay = INT_MIN;
+
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        const auto& t = transactions[i];
+        if (t.amount == 0 || (i < excluded.size() && excluded[i])) continue;
+
+        int day;
+        if (!DateParser::tryDayNumber(t.date, day)) continue;
+        newestDay = std::max(newestDay, day);
+
+        const std::string& merchant = merchantKey(t);
+        if (merchant.empty()) continue;
+
+        uint64_t key = mt::hashBytes(merchant);
+        key = mt::combineHash(key, mt::hashBytes(t.accountName));
+        key = mt::combineHash(key, t.amount < 0 ? 1 : 0);
+        entries.push_back({key, std::log(std::abs(t.amount)), day, static_cast<uint32_t>(i)});
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.key != b.key ? a.key < b.key : a.magnitude < b.magnitude;
+    });
+
+    // Cut each key's amount-sorted run into clusters spanning at most the tolerance (on a log
+    // scale, so it stays relative), then put each cluster in date order. Clusters start at the
+    // data rather than on a fixed grid, so near-equal amounts are never split by a band edge.
+    std::vector<size_t> clusterEnds;
+    for (size_t begin = 0; begin < entries.size();) {
+        size_t end = begin + 1;
+        while (end < entries.size() && entries[end].key == entries[begin].key &&
+               entries[end].magnitude - entries[begin].magnitude <= bandWidth) {
+            ++end;
+        }
+        std::sort(entries.begin() + begin, entries.begin() + end,
+                  [](const Entry& a, const Entry& b) { return a.day < b.day; });
+        clusterEnds.push_back(end);
+        begin = end;
+    }
+
+    std::vector<RecurringSeries> result;
+    std::vector<const Entry*> occurrences;
+    std::vector<int> intervals;
+
+    size_t begin = 0;
+    for (size_t end : clusterEnds) {
+        // One occurrence per day; same-day repeats are not a period
+        occurrences.clear();
+        for (size_t i = begin; i < end; ++i) {
+            if (occurrences.empty() || occurrences.back()->day != entries[i].day) {
+                occurrences.push_back(&entries[i]);
+            }
+        }
+        begin = end;
+        if (occurrences.size() < 2) continue;
+
+        intervals.clear();
+        for (size_t i = 1; i < occurrences.size(); ++i) {
+            intervals.push_back(occurrences[i]->day - occurrences[i - 1]->day);
+        }
+        std::vector<int> sorted = intervals;
+        std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+        int median = sorted[sorted.size() / 2];
+
+        const PeriodRule* rule = nullptr;
+        for (const auto& candidate : kPeriodRules) {
+            if (median >= candidate.minDays && median <= candidate.maxDays) rule = &candidate;
+        }
+        if (!rule) continue;
+
+        // Annual charges rarely have three years of history
+        size_t required = rule->period == RecurrencePeriod::Annual ? 2 : minOccurrences;
+        if (occurrences.size() < required) continue;
+
+        size_t regular = std::count_if(intervals.begin(), intervals.end(), [&](int interval) {
+            return std::abs(interval - median) <= rule->slack;
+        });
+        if (regular < kMinRegularity * intervals.size()) continue;
+
+        const Transaction& latest = transactions[occurrences.back()->index];
+        RecurringSeries series;
+        series.merchant = merchantKey(latest);
+        series.accountName = latest.accountName;
+        series.category = latest.category;
+        series.period = rule->period;
+        series.occurrences = occurrences.size();
+        series.firstDate = transactions[occurrences.front()->index].date;
+        series.lastDate = latest.date;
+        series.nextExpectedDate = RecurringDetector::nextDate(latest.date, rule->period);
+        series.active = newestDay - occurrences.back()->day <= rule->nominalDays * 3 / 2;
+
+        double total = 0.0;
+        for (const Entry* entry : occurrences) total += transactions[entry->index].amount;
+        series.averageAmount = total / occurrences.size();
+
+        // Expect the recent level rather than the long-run mean (price changes)
+        size_t recent = std::min<size_t>(3, occurrences.size());
+        double recentTotal = 0.0;
+        double recentStatement = 0.0;
+        for (size_t i = occurrences.size() - recent; i < occurrences.size(); ++i) {
+            recentTotal += transactions[occurrences[i]->index].amount;
+            recentStatement += transactions[occurrences[i]->index].statementAmount();
+        }
+        series.nextExpectedAmount = recentTotal / recent;
+        series.nextStatementAmount = recentStatement / recent;
+
+        result.push_back(std::move(series));
+    }
+
+    std::sort(result.begin(), result.end(), [](const RecurringSeries& a, const RecurringSeries& b) {
+        return a.merchant != b.merchant ? a.merchant < b.merchant : a.accountName < b.accountName;
+    });
+    return result;
+}
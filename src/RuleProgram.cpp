@@ -0,0 +1,215 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "RuleProgram.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+bool hasDigit(const std::string& s) {
+    return std::any_of(s.begin(), s.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+void setBit(std::vector<uint64_t>& bits, size_t offset, uint32_t index) {
+    bits[offset + (index >> 6)] |= uint64_t(1) << (index & 63);
+}
+
+void appendWord(std::string& key, uint32_t value) {
+    char bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+    key.append(bytes, sizeof(bytes));
+}
+
+uint32_t bucket(const std::vector<int64_t>& bounds, int64_t value) {
+    return static_cast<uint32_t>(std::upper_bound(bounds.begin(), bounds.end(), value) -
+                                 bounds.begin());
+}
+
+} // namespace
+
+RuleProgram::RuleProgram() : words(0), keywordOnly(true), hasKeywords(false), digitsMatter(false) {
+}
+
+int32_t RuleProgram::dateKey(std::string_view date) {
+    if (date.size() != 10 || date[4] != '-' || date[7] != '-') return -1;
+    int32_t key = 0;
+    for (size_t i = 0; i < date.size(); ++i) {
+        if (i == 4 || i == 7) continue;
+        if (date[i] < '0' || date[i] > '9') return -1;
+        key = key * 10 + (date[i] - '0');
+    }
+    return key;
+}
+
+int64_t RuleProgram::cents(double amount) {
+    if (!(std::abs(amount) < 1e15)) return kNoCents;  // Unknown (NaN) or absurd
+    return std::llround(amount * 100.0);
+}
+
+uint32_t RuleProgram::accountId(std::string_view account) const {
+    auto it = accountIds.find(std::string(account));
+    return it == accountIds.end() ? 0 : it->second;
+}
+
+void RuleProgram::build(const std::vector<CategoryRule>& rules) {
+    words = (rules.size() + 63) / 64;
+    steps.assign(rules.size(), Step{0, 0, 0, 0, 0, 0});
+    patterns.clear();
+    keywordFree.assign(words, 0);
+    accountIds.clear();
+    accountMasks.clear();
+    amountBounds.clear();
+    dateBounds.clear();
+    keywordOnly = true;
+    hasKeywords = false;
+    digitsMatter = false;
+    
+    std::unordered_map<std::string, uint32_t> patternIds;
+    for (uint32_t r = 0; r < rules.size(); ++r) {
+        const CategoryRule& rule = rules[r];
+        Step& step = steps[r];
+        
+        if (rule.keywords.empty()) {
+            setBit(keywordFree, 0, r);
+            keywordOnly = false;
+        }
+        hasKeywords = hasKeywords || !rule.keywords.empty();
+        digitsMatter = digitsMatter ||
+                       std::any_of(rule.keywords.begin(), rule.keywords.end(), hasDigit);
+        
+        if (rule.hasAmountRange()) {
+            step.flags |= kAmount;
+            step.minCents = std::isinf(rule.minAmount) ? kNoCents + 1 : cents(rule.minAmount);
+            step.maxCents = std::isinf(rule.maxAmount) ? std::numeric_limits<int64_t>::max()
+                                                       : cents(rule.maxAmount);
+            if (!std::isinf(rule.minAmount)) amountBounds.push_back(step.minCents);
+            if (!std::isinf(rule.maxAmount)) amountBounds.push_back(step.maxCents + 1);
+        }
+        if (!rule.startDate.empty() || !rule.endDate.empty()) {
+            step.flags |= kDate;
+            step.firstDay = rule.startDate.empty() ? 0 : dateKey(rule.startDate);
+            step.lastDay = rule.endDate.empty() ? std::numeric_limits<int32_t>::max()
+                                                : dateKey(rule.endDate);
+            if (step.firstDay < 0 || step.lastDay < 0) {
+                throw std::invalid_argument("Invalid date range in rule for " + rule.category);
+            }
+            if (!rule.startDate.empty()) dateBounds.push_back(step.firstDay);
+            if (!rule.endDate.empty()) dateBounds.push_back(int64_t(step.lastDay) + 1);
+        }
+        if (!rule.pattern.empty()) {
+            step.flags |= kPattern;
+            digitsMatter = true;
+            auto inserted = patternIds.emplace(rule.pattern,
+                                               static_cast<uint32_t>(patterns.size()));
+            if (inserted.second) {
+                try {
+                    patterns.emplace_back(rule.pattern, std::regex::ECMAScript |
+                                                        std::regex::icase | std::regex::optimize);
+                } catch (const std::regex_error& e) {
+                    throw std::invalid_argument("Invalid pattern \"" + rule.pattern + "\" for " +
+                                                rule.category + ": " + e.what());
+                }
+            }
+            step.pattern = inserted.first->second;
+        }
+        if (!rule.account.empty()) {
+            accountIds.emplace(rule.account, static_cast<uint32_t>(accountIds.size() + 1));
+        }
+        keywordOnly = keywordOnly && step.flags == 0 && rule.account.empty();
+    }
+    
+    if (!accountIds.empty()) {
+        // Row 0 holds the rules open to every account; each named account adds its own
+        accountMasks.assign((accountIds.size() + 1) * words, 0);
+        for (uint32_t r = 0; r < rules.size(); ++r) {
+            if (rules[r].account.empty()) setBit(accountMasks, 0, r);
+        }
+        for (size_t id = 1; id <= accountIds.size(); ++id) {
+            std::copy(accountMasks.begin(), accountMasks.begin() + words,
+                      accountMasks.begin() + id * words);
+        }
+        for (uint32_t r = 0; r < rules.size(); ++r) {
+            if (!rules[r].account.empty()) {
+                setBit(accountMasks, accountIds[rules[r].account] * words, r);
+            }
+        }
+    }
+    
+    for (auto* bounds : {&amountBounds, &dateBounds}) {
+        std::sort(bounds->begin(), bounds->end());
+        bounds->erase(std::unique(bounds->begin(), bounds->end()), bounds->end());
+    }
+}
+
+void RuleProgram::compile(const std::vector<CategoryRule>& rules) {
+    RuleProgram next;
+    next.build(rules);
+    std::vector<std::vector<std::string>> keywords;
+    keywords.reserve(rules.size());
+    for (const auto& rule : rules) {
+        keywords.push_back(rule.keywords);
+    }
+    next.matcher.compile(keywords);
+    *this = std::move(next);
+}
+
+bool RuleProgram::attach(const std::vector<CategoryRule>& rules, const uint32_t* data,
+                         size_t count) {
+    RuleProgram next;
+    uint32_t ruleCount = static_cast<uint32_t>(rules.size());
+    if (next.matcher.attach(data, count, ruleCount) != count) return false;
+    next.build(rules);
+    *this = std::move(next);
+    return true;
+}
+
+uint32_t RuleProgram::evaluate(const CategorizationInput& input) const {
+    if (keywordOnly) return matcher.match(input.description);
+    
+    thread_local std::vector<uint64_t> candidates;
+    candidates.assign(keywordFree.begin(), keywordFree.end());
+    if (hasKeywords) matcher.matchAll(input.description, candidates.data());
+    if (!accountMasks.empty()) {
+        const uint64_t* allowed = accountMasks.data() + accountId(input.account) * words;
+        for (size_t w = 0; w < words; ++w) candidates[w] &= allowed[w];
+    }
+    
+    int64_t amount = cents(input.amount);
+    int32_t day = dateKey(input.date);
+    for (size_t w = 0; w < words; ++w) {
+        for (uint64_t bits = candidates[w]; bits != 0; bits &= bits - 1) {
+            uint32_t r = static_cast<uint32_t>(w * 64 + __builtin_ctzll(bits));
+            const Step& step = steps[r];
+            if ((step.flags & kAmount) &&
+                (amount == kNoCents || amount < step.minCents || amount > step.maxCents)) {
+                continue;
+            }
+            if ((step.flags & kDate) && (day < 0 || day < step.firstDay || day > step.lastDay)) {
+                continue;
+            }
+            if ((step.flags & kPattern) &&
+                !std::regex_search(input.description.begin(), input.description.end(),
+                                   patterns[step.pattern])) {
+                continue;
+            }
+            return r;
+        }
+    }
+    return npos;
+}
+
+void RuleProgram::appendContext(const CategorizationInput& input, std::string& key) const {
+    // Fixed width per program, so the suffix never blurs into the description
+    if (!accountMasks.empty()) appendWord(key, accountId(input.account));
+    if (!amountBounds.empty()) {
+        int64_t amount = cents(input.amount);
+        appendWord(key, amount == kNoCents ? UINT32_MAX : bucket(amountBounds, amount));
+    }
+    if (!dateBounds.empty()) {
+        int32_t day = dateKey(input.date);
+        appendWord(key, day < 0 ? UINT32_MAX : bucket(dateBounds, day));
+    }
+}
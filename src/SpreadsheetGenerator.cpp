@@ -18,12 +18,25 @@
 //SpreadsheetGenerator.cpp
 
 #include "SpreadsheetGenerator.h"
+#include "CurrencyConverter.h"
 #include "xlsxwriter.h"
 #include <cmath>
 #include <iomanip>
+#include <map>
 #include <sstream>
 
-SpreadsheetGenerator::SpreadsheetGenerator() {}
+SpreadsheetGenerator::SpreadsheetGenerator() : currencyFormat("$#,##0.00") {}
+
+void SpreadsheetGenerator::setReportingCurrency(const std::string& currency) {
+    reportingCurrency = currency;
+    currencyFormat = numberFormat(currency);
+}
+
+std::string SpreadsheetGenerator::numberFormat(const std::string& currency) const {
+    std::string symbol = CurrencyConverter::symbol(currency.empty() ? reportingCurrency : currency);
+    // Anything but $ has to be quoted to be taken literally in an Excel number format
+    return (symbol == "$" ? symbol : "\"" + symbol + "\"") + "#,##0.00";
+}
 
 bool SpreadsheetGenerator::generateSpreadsheet(const TransactionData& data,
                                                const BudgetAnalyzer& analyzer,
@@ -52,6 +65,41 @@ bool SpreadsheetGenerator::generateSpreadsheet(const TransactionData& data,
         return false;
     }
     
+    if (!createCategoryTreeSheet(workbook, analyzer)) {
+        workbook_close(workbook);
+        return false;
+    }
+    
+    if (!createMerchantSheet(workbook, analyzer)) {
+        workbook_close(workbook);
+        return false;
+    }
+    
+    if (!createRecurringSheet(workbook, analyzer)) {
+        workbook_close(workbook);
+        return false;
+    }
+    
+    if (forecastMonths > 0 && !createForecastSheet(workbook, analyzer)) {
+        workbook_close(workbook);
+        return false;
+    }
+    
+    if (!createReconciliationSheet(workbook, analyzer) ||
+        !createCashFlowSheet(workbook, analyzer)) {
+        workbook_close(workbook);
+        return false;
+    }
+    
+    auto cube = analyzer.getDataCube();
+    if (!createPivotSheet(workbook, "Category x Month", *cube,
+                          CubeAxis::Category, CubeAxis::Period) ||
+        !createPivotSheet(workbook, "Category x Account", *cube,
+                          CubeAxis::Category, CubeAxis::Account)) {
+        workbook_close(workbook);
+        return false;
+    }
+    
     workbook_close(workbook);
     return true;
 }
@@ -70,15 +118,15 @@ bool SpreadsheetGenerator::createSummarySheet(void* wb, const BudgetAnalyzer& an
     format_set_bold(label_format);
     
     lxw_format* currency_format = workbook_add_format(workbook);
-    format_set_num_format(currency_format, "$#,##0.00");
+    format_set_num_format(currency_format, currencyFormat.c_str());
     
     worksheet_set_column(worksheet, 0, 1, 30, NULL);
     
     // Title
     worksheet_write_string(worksheet, 0, 0, "Budget Summary", header_format);
     
-    // Get summary data (cast away const for this call)
-    BudgetSummary summary = const_cast<BudgetAnalyzer&>(analyzer).analyzeBudget();
+    // Memoized by the analyzer, so this does not rescan the transactions
+    BudgetSummary summary = analyzer.analyzeBudget();
     
     int row = 2;
     worksheet_write_string(worksheet, row, 0, "Total Income:", label_format);
@@ -91,6 +139,14 @@ bool SpreadsheetGenerator::createSummarySheet(void* wb, const BudgetAnalyzer& an
     
     worksheet_write_string(worksheet, row, 0, "Net Change:", label_format);
     worksheet_write_number(worksheet, row, 1, summary.netChange, currency_format);
+    row++;
+    
+    worksheet_write_string(worksheet, row, 0, "Distinct Merchants (est.):", label_format);
+    worksheet_write_number(worksheet, row, 1, std::round(summary.distinctMerchants), NULL);
+    row++;
+    
+    worksheet_write_string(worksheet, row, 0, "Transfers Between Accounts:", label_format);
+    worksheet_write_number(worksheet, row, 1, summary.transferVolume, currency_format);
     row += 2;
     
     worksheet_write_string(worksheet, row, 0, "Spending by Category:", header_format);
@@ -115,7 +171,7 @@ bool SpreadsheetGenerator::createTransactionSheet(void* wb, const TransactionDat
     format_set_bg_color(header_format, 0xCCCCCC);
     
     lxw_format* currency_format = workbook_add_format(workbook);
-    format_set_num_format(currency_format, "$#,##0.00");
+    format_set_num_format(currency_format, currencyFormat.c_str());
     
     // Set column widths
     worksheet_set_column(worksheet, 0, 0, 12, NULL);
@@ -159,7 +215,7 @@ bool SpreadsheetGenerator::createCategorySheet(void* wb, const TransactionData&
     format_set_bg_color(header_format, 0xCCCCCC);
     
     lxw_format* currency_format = workbook_add_format(workbook);
-    format_set_num_format(currency_format, "$#,##0.00");
+    format_set_num_format(currency_format, currencyFormat.c_str());
     
     worksheet_set_column(worksheet, 0, 0, 20, NULL);
     worksheet_set_column(worksheet, 1, 1, 15, NULL);
@@ -168,7 +224,7 @@ bool SpreadsheetGenerator::createCategorySheet(void* wb, const TransactionData&
     worksheet_write_string(worksheet, 0, 1, "Total Spending", header_format);
     
     (void)data;
-    auto categoryAnalysis = const_cast<BudgetAnalyzer&>(analyzer).getCategoryAnalysis();
+    auto categoryAnalysis = analyzer.getCategoryAnalysis();
     int row = 1;
     for (const auto& pair : categoryAnalysis) {
         worksheet_write_string(worksheet, row, 0, pair.first.c_str(), NULL);
@@ -189,7 +245,7 @@ bool SpreadsheetGenerator::createMonthlySheet(void* wb, const TransactionData& d
     format_set_bg_color(header_format, 0xCCCCCC);
     
     lxw_format* currency_format = workbook_add_format(workbook);
-    format_set_num_format(currency_format, "$#,##0.00");
+    format_set_num_format(currency_format, currencyFormat.c_str());
     
     worksheet_set_column(worksheet, 0, 0, 15, NULL);
     worksheet_set_column(worksheet, 1, 1, 15, NULL);
@@ -198,7 +254,7 @@ bool SpreadsheetGenerator::createMonthlySheet(void* wb, const TransactionData& d
     worksheet_write_string(worksheet, 0, 1, "Total Spending", header_format);
     
     (void)data;
-    auto monthlyTrends = const_cast<BudgetAnalyzer&>(analyzer).getMonthlyTrends();
+    auto monthlyTrends = analyzer.getMonthlyTrends();
     int row = 1;
     for (const auto& pair : monthlyTrends) {
         worksheet_write_string(worksheet, row, 0, pair.first.c_str(), NULL);
@@ -209,6 +265,334 @@ bool SpreadsheetGenerator::createMonthlySheet(void* wb, const TransactionData& d
     return true;
 }
 
+bool SpreadsheetGenerator::createMerchantSheet(void* wb, const BudgetAnalyzer& analyzer) {
+    lxw_workbook* workbook = static_cast<lxw_workbook*>(wb);
+    lxw_worksheet* worksheet = workbook_add_worksheet(workbook, "Top Merchants");
+    if (!worksheet) return false;
+    
+    lxw_format* header_format = workbook_add_format(workbook);
+    format_set_bold(header_format);
+    format_set_bg_color(header_format, 0xCCCCCC);
+    
+    lxw_format* currency_format = workbook_add_format(workbook);
+    format_set_num_format(currency_format, currencyFormat.c_str());
+    
+    worksheet_set_column(worksheet, 0, 0, 30, NULL);
+    worksheet_set_column(worksheet, 1, 1, 15, NULL);
+    worksheet_set_column(worksheet, 3, 3, 30, NULL);
+    worksheet_set_column(worksheet, 4, 4, 15, NULL);
+    
+    worksheet_write_string(worksheet, 0, 0, "Merchant", header_format);
+    worksheet_write_string(worksheet, 0, 1, "Total Spending", header_format);
+    worksheet_write_string(worksheet, 0, 3, "Merchant", header_format);
+    worksheet_write_string(worksheet, 0, 4, "Purchases", header_format);
+    
+    MerchantReport report = analyzer.getTopMerchants(50);
+    int row = 1;
+    for (const auto& merchant : report.bySpend) {
+        worksheet_write_string(worksheet, row, 0, merchant.key.c_str(), NULL);
+        worksheet_write_number(worksheet, row, 1, merchant.weight, currency_format);
+        row++;
+    }
+    
+    row = 1;
+    for (const auto& merchant : report.byCount) {
+        worksheet_write_string(worksheet, row, 3, merchant.key.c_str(), NULL);
+        worksheet_write_number(worksheet, row, 4, merchant.weight, NULL);
+        row++;
+    }
+    
+    return true;
+}
+
+bool SpreadsheetGenerator::createRecurringSheet(void* wb, const BudgetAnalyzer& analyzer) {
+    lxw_workbook* workbook = static_cast<lxw_workbook*>(wb);
+    lxw_worksheet* worksheet = workbook_add_worksheet(workbook, "Recurring");
+    if (!worksheet) return false;
+    
+    lxw_format* header_format = workbook_add_format(workbook);
+    format_set_bold(header_format);
+    format_set_bg_color(header_format, 0xCCCCCC);
+    
+    lxw_format* currency_format = workbook_add_format(workbook);
+    format_set_num_format(currency_format, currencyFormat.c_str());
+    
+    worksheet_set_column(worksheet, 0, 0, 30, NULL);
+    worksheet_set_column(worksheet, 1, 2, 15, NULL);
+    worksheet_set_column(worksheet, 3, 3, 12, NULL);
+    worksheet_set_column(worksheet, 4, 8, 15, NULL);
+    
+    const char* headers[] = {"Merchant", "Account", "Category", "Period", "Occurrences",
+                             "Average Amount", "Last Date", "Next Expected", "Next Amount"};
+    for (int col = 0; col < 9; ++col) {
+        worksheet_write_string(worksheet, 0, col, headers[col], header_format);
+    }
+    
+    int row = 1;
+    for (const auto& series : analyzer.getRecurringPayments()) {
+        if (!series.active) continue;
+        std::string period = RecurringDetector::periodName(series.period);
+        worksheet_write_string(worksheet, row, 0, series.merchant.c_str(), NULL);
+        worksheet_write_string(worksheet, row, 1, series.accountName.c_str(), NULL);
+        worksheet_write_string(worksheet, row, 2, series.category.c_str(), NULL);
+        worksheet_write_string(worksheet, row, 3, period.c_str(), NULL);
+        worksheet_write_number(worksheet, row, 4, series.occurrences, NULL);
+        worksheet_write_number(worksheet, row, 5, series.averageAmount, currency_format);
+        worksheet_write_string(worksheet, row, 6, series.lastDate.c_str(), NULL);
+        worksheet_write_string(worksheet, row, 7, series.nextExpectedDate.c_str(), NULL);
+        worksheet_write_number(worksheet, row, 8, series.nextExpectedAmount, currency_format);
+        row++;
+    }
+    
+    return true;
+}
+
+bool SpreadsheetGenerator::createForecastSheet(void* wb, const BudgetAnalyzer& analyzer) {
+    lxw_workbook* workbook = static_cast<lxw_workbook*>(wb);
+    lxw_worksheet* worksheet = workbook_add_worksheet(workbook, "Forecast");
+    if (!worksheet) return false;
+    
+    lxw_format* header_format = workbook_add_format(workbook);
+    format_set_bold(header_format);
+    format_set_bg_color(header_format, 0xCCCCCC);
+    
+    lxw_format* currency_format = workbook_add_format(workbook);
+    format_set_num_format(currency_format, currencyFormat.c_str());
+    
+    ForecastResult forecast = analyzer.getSpendingForecast(forecastMonths);
+    
+    worksheet_set_column(worksheet, 0, 0, 25, NULL);
+    worksheet_set_column(worksheet, 1, 2, 15, NULL);
+    worksheet_set_column(worksheet, 3, 3 + static_cast<int>(forecast.months.size()), 12, NULL);
+    
+    worksheet_write_string(worksheet, 0, 0, "Category", header_format);
+    worksheet_write_string(worksheet, 0, 1, "Account", header_format);
+    worksheet_write_string(worksheet, 0, 2, "Model", header_format);
+    for (size_t m = 0; m < forecast.months.size(); ++m) {
+        worksheet_write_string(worksheet, 0, 3 + m, forecast.months[m].c_str(), header_format);
+    }
+    worksheet_freeze_panes(worksheet, 1, 3);
+    
+    int row = 1;
+    for (const auto& group : forecast.groups) {
+        worksheet_write_string(worksheet, row, 0, group.category.c_str(), NULL);
+        worksheet_write_string(worksheet, row, 1, group.accountName.c_str(), NULL);
+        worksheet_write_string(worksheet, row, 2, group.method.c_str(), NULL);
+        for (size_t m = 0; m < group.values.size(); ++m) {
+            worksheet_write_number(worksheet, row, 3 + m, group.values[m], currency_format);
+        }
+        row++;
+    }
+    
+    return true;
+}
+
+bool SpreadsheetGenerator::createReconciliationSheet(void* wb, const BudgetAnalyzer& analyzer) {
+    lxw_workbook* workbook = static_cast<lxw_workbook*>(wb);
+    lxw_worksheet* worksheet = workbook_add_worksheet(workbook, "Reconciliation");
+    if (!worksheet) return false;
+    
+    lxw_format* header_format = workbook_add_format(workbook);
+    format_set_bold(header_format);
+    format_set_bg_color(header_format, 0xCCCCCC);
+    
+    // Balances stay in each account's statement currency, one format per currency
+    std::map<std::string, lxw_format*> currency_formats;
+    auto currency_format_for = [&](const std::string& currency) {
+        lxw_format*& format = currency_formats[currency];
+        if (!format) {
+            format = workbook_add_format(workbook);
+            format_set_num_format(format, numberFormat(currency).c_str());
+        }
+        return format;
+    };
+    
+    worksheet_set_column(worksheet, 0, 0, 20, NULL);
+    worksheet_set_column(worksheet, 1, 2, 18, NULL);
+    worksheet_set_column(worksheet, 3, 3, 35, NULL);
+    worksheet_set_column(worksheet, 4, 5, 15, NULL);
+    
+    const char* headers[] = {"Account", "Issue", "Date", "Description", "Amount", "Days"};
+    for (int col = 0; col < 6; ++col) {
+        worksheet_write_string(worksheet, 0, col, headers[col], header_format);
+    }
+    
+    int row = 1;
+    for (const auto& account : analyzer.getReconciliation()) {
+        lxw_format* currency_format = currency_format_for(account.currency);
+        for (const auto& flag : account.flags) {
+            std::string issue = Reconciler::issueName(flag.issue);
+            worksheet_write_string(worksheet, row, 0, account.accountName.c_str(), NULL);
+            worksheet_write_string(worksheet, row, 1, issue.c_str(), NULL);
+            worksheet_write_string(worksheet, row, 2, flag.date.c_str(), NULL);
+            worksheet_write_string(worksheet, row, 3, flag.description.c_str(), NULL);
+            worksheet_write_number(worksheet, row, 4, flag.amount, currency_format);
+            if (flag.days > 0) worksheet_write_number(worksheet, row, 5, flag.days, NULL);
+            row++;
+        }
+    }
+    
+    return true;
+}
+
+bool SpreadsheetGenerator::createCashFlowSheet(void* wb, const BudgetAnalyzer& analyzer) {
+    lxw_workbook* workbook = static_cast<lxw_workbook*>(wb);
+    lxw_worksheet* worksheet = workbook_add_worksheet(workbook, "Cash Flow");
+    if (!worksheet) return false;
+    
+    lxw_format* header_format = workbook_add_format(workbook);
+    format_set_bold(header_format);
+    format_set_bg_color(header_format, 0xCCCCCC);
+    
+    // Projected balances are in statement currency too (see the Reconciliation sheet)
+    std::map<std::string, lxw_format*> currency_formats;
+    auto currency_format_for = [&](const std::string& currency) {
+        lxw_format*& format = currency_formats[currency];
+        if (!format) {
+            format = workbook_add_format(workbook);
+            format_set_num_format(format, numberFormat(currency).c_str());
+        }
+        return format;
+    };
+    
+    worksheet_set_column(worksheet, 0, 1, 15, NULL);
+    worksheet_set_column(worksheet, 2, 2, 30, NULL);
+    worksheet_set_column(worksheet, 3, 4, 15, NULL);
+    
+    const char* headers[] = {"Account", "Date", "Description", "Amount", "Balance"};
+    for (int col = 0; col < 5; ++col) {
+        worksheet_write_string(worksheet, 0, col, headers[col], header_format);
+    }
+    
+    int row = 1;
+    for (const auto& projection : analyzer.getCashFlowProjection()) {
+        lxw_format* currency_format = currency_format_for(projection.currency);
+        worksheet_write_string(worksheet, row, 0, projection.accountName.c_str(), NULL);
+        worksheet_write_string(worksheet, row, 2, "Current balance", NULL);
+        worksheet_write_number(worksheet, row, 4, projection.startingBalance, currency_format);
+        row++;
+        for (const auto& point : projection.points) {
+            worksheet_write_string(worksheet, row, 0, projection.accountName.c_str(), NULL);
+            worksheet_write_string(worksheet, row, 1, point.date.c_str(), NULL);
+            worksheet_write_string(worksheet, row, 2, point.description.c_str(), NULL);
+            worksheet_write_number(worksheet, row, 3, point.amount, currency_format);
+            worksheet_write_number(worksheet, row, 4, point.balance, currency_format);
+            row++;
+        }
+    }
+    
+    return true;
+}
+
+bool SpreadsheetGenerator::createCategoryTreeSheet(void* wb, const BudgetAnalyzer& analyzer) {
+    lxw_workbook* workbook = static_cast<lxw_workbook*>(wb);
+    lxw_worksheet* worksheet = workbook_add_worksheet(workbook, "Category Tree");
+    if (!worksheet) return false;
+    
+    lxw_format* header_format = workbook_add_format(workbook);
+    format_set_bold(header_format);
+    format_set_bg_color(header_format, 0xCCCCCC);
+    
+    lxw_format* currency_format = workbook_add_format(workbook);
+    format_set_num_format(currency_format, currencyFormat.c_str());
+    
+    // Excel supports seven outline levels; deeper categories share the last one
+    const int maxLevel = 7;
+    lxw_format* indent_formats[maxLevel + 1];
+    for (int level = 0; level <= maxLevel; ++level) {
+        indent_formats[level] = workbook_add_format(workbook);
+        format_set_indent(indent_formats[level], level);
+        if (level == 0) format_set_bold(indent_formats[level]);
+    }
+    
+    worksheet_set_column(worksheet, 0, 0, 30, NULL);
+    worksheet_set_column(worksheet, 1, 3, 15, NULL);
+    
+    // Parent categories are written above their children, so put the collapse buttons there
+    worksheet_outline_settings(worksheet, LXW_TRUE, LXW_FALSE, LXW_TRUE, LXW_FALSE);
+    
+    const char* headers[] = {"Category", "Total Spending", "Direct Spending", "Transactions"};
+    for (int col = 0; col < 4; ++col) {
+        worksheet_write_string(worksheet, 0, col, headers[col], header_format);
+    }
+    
+    auto tree = analyzer.getCategoryTree();
+    const auto& nodes = tree->getNodes();
+    
+    int row = 1;
+    for (size_t id : tree->preOrder()) {
+        const CategoryNode& node = nodes[id];
+        int level = std::min(node.depth, maxLevel);
+        
+        lxw_row_col_options options = {0, 0, 0};
+        options.level = static_cast<uint8_t>(level);
+        worksheet_set_row_opt(worksheet, row, LXW_DEF_ROW_HEIGHT, NULL, &options);
+        
+        worksheet_write_string(worksheet, row, 0, node.name.c_str(), indent_formats[level]);
+        worksheet_write_number(worksheet, row, 1, -node.total.spending, currency_format);
+        worksheet_write_number(worksheet, row, 2, -node.direct.spending, currency_format);
+        worksheet_write_number(worksheet, row, 3, node.total.count, NULL);
+        row++;
+    }
+    
+    return true;
+}
+
+bool SpreadsheetGenerator::createPivotSheet(void* wb, const char* name, const DataCube& cube,
+                                            CubeAxis rows, CubeAxis columns) {
+    lxw_workbook* workbook = static_cast<lxw_workbook*>(wb);
+    lxw_worksheet* worksheet = workbook_add_worksheet(workbook, name);
+    if (!worksheet) return false;
+    
+    lxw_format* header_format = workbook_add_format(workbook);
+    format_set_bold(header_format);
+    format_set_bg_color(header_format, 0xCCCCCC);
+    
+    lxw_format* currency_format = workbook_add_format(workbook);
+    format_set_num_format(currency_format, currencyFormat.c_str());
+    
+    const auto& rowLabels = cube.labels(rows);
+    const auto& columnLabels = cube.labels(columns);
+    int totalColumn = static_cast<int>(columnLabels.size()) + 1;
+    
+    worksheet_set_column(worksheet, 0, 0, 25, NULL);
+    worksheet_set_column(worksheet, 1, totalColumn, 12, NULL);
+    
+    worksheet_write_string(worksheet, 0, 0, "Spending", header_format);
+    for (size_t c = 0; c < columnLabels.size(); ++c) {
+        worksheet_write_string(worksheet, 0, 1 + c, columnLabels[c].c_str(), header_format);
+    }
+    worksheet_write_string(worksheet, 0, totalColumn, "Total", header_format);
+    worksheet_freeze_panes(worksheet, 1, 1);
+    
+    // Every figure comes from the cube; the raw transactions are not revisited
+    std::vector<CubeCell> matrix = cube.pivot(rows, columns);
+    std::vector<CubeCell> rowTotals = cube.rollUp(rows);
+    std::vector<CubeCell> columnTotals = cube.rollUp(columns);
+    
+    int row = 1;
+    for (size_t r = 0; r < rowLabels.size(); ++r) {
+        worksheet_write_string(worksheet, row, 0, rowLabels[r].c_str(), NULL);
+        for (size_t c = 0; c < columnLabels.size(); ++c) {
+            double spending = matrix[r * columnLabels.size() + c].spending;
+            if (spending < 0) {
+                worksheet_write_number(worksheet, row, 1 + c, -spending, currency_format);
+            }
+        }
+        worksheet_write_number(worksheet, row, totalColumn, -rowTotals[r].spending,
+                               currency_format);
+        row++;
+    }
+    
+    worksheet_write_string(worksheet, row, 0, "Total", header_format);
+    for (size_t c = 0; c < columnLabels.size(); ++c) {
+        worksheet_write_number(worksheet, row, 1 + c, -columnTotals[c].spending, currency_format);
+    }
+    worksheet_write_number(worksheet, row, totalColumn, -cube.total().spending, currency_format);
+    
+    return true;
+}
+
 bool SpreadsheetGenerator::createCharts(void* wb, const TransactionData& data, const BudgetAnalyzer& analyzer) {
     (void)wb;
     (void)data;
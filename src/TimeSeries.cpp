@@ -0,0 +1,174 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "TimeSeries.h"
+#include "DateParser.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+SpendingTimeSeries::SpendingTimeSeries(const TransactionData& data, Granularity granularity,
+                                       const std::vector<bool>& excluded)
+    : granularity(granularity), firstKey(0), periods(0), activePeriods(0) {
+    const auto& transactions = data.getAllTransactions();
+
+    // Pass 1: resolve each row to a period key and category id
+    std::vector<int> keys(transactions.size(), INT_MIN);
+    std::vector<size_t> rowCategories(transactions.size(), 0);
+    int minKey = INT_MAX;
+    int maxKey = INT_MIN;
+
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        if (i < excluded.size() && excluded[i]) continue;
+        const auto& t = transactions[i];
+        keys[i] = periodKey(t.date);
+        if (keys[i] == INT_MIN) continue;  // Undated rows cannot be placed on the time axis
+        minKey = std::min(minKey, keys[i]);
+        maxKey = std::max(maxKey, keys[i]);
+
+        auto it = categoryIndex.find(t.category);
+        if (it == categoryIndex.end()) {
+            it = categoryIndex.emplace(t.category, categories.size()).first;
+            categories.push_back(t.category);
+        }
+        rowCategories[i] = it->second;
+    }
+
+    if (minKey > maxKey) return;
+
+    firstKey = minKey;
+    periods = static_cast<size_t>(maxKey - minKey) + 1;
+    size_t stride = periods + 1;
+    size_t totalRow = categories.size();
+    prefix.assign((categories.size() + 1) * stride, 0.0);
+    counts.assign(periods, 0);
+
+    // Pass 2: bin into periods (offset by one so the prefix scan can run in place)
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        if (keys[i] == INT_MIN) continue;
+        size_t period = static_cast<size_t>(keys[i] - firstKey);
+        counts[period]++;
+        double spend = transactions[i].amount < 0 ? transactions[i].amount : 0;
+        prefix[rowCategories[i] * stride + period + 1] += spend;
+        prefix[totalRow * stride + period + 1] += spend;
+    }
+
+    for (size_t r = 0; r <= categories.size(); ++r) {
+        double* p = &prefix[r * stride];
+        for (size_t j = 1; j < stride; ++j) {
+            p[j] += p[j - 1];
+        }
+    }
+
+    activePeriods = std::count_if(counts.begin(), counts.end(), [](uint32_t c) { return c > 0; });
+}
+
+int SpendingTimeSeries::periodKey(const std::string& date) const {
+    int dayNumber;
+    if (!DateParser::tryDayNumber(date, dayNumber)) return INT_MIN;
+    // tryDayNumber has validated the YYYY-MM-DD digits
+    int year = (date[0] - '0') * 1000 + (date[1] - '0') * 100 + (date[2] - '0') * 10 +
+               (date[3] - '0');
+    int month = (date[5] - '0') * 10 + (date[6] - '0');
+
+    switch (granularity) {
+        case Granularity::Week:
+            // 1970-01-01 was a Thursday; shift so weeks start on Monday
+            return static_cast<int>(std::floor((dayNumber + 3) / 7.0));
+        case Granularity::Month:
+            return year * 12 + (month - 1);
+        case Granularity::Quarter:
+            return year * 4 + (month - 1) / 3;
+        case Granularity::Year:
+            return year;
+    }
+    return year;
+}
+
+int SpendingTimeSeries::periodsPerYear() const {
+    switch (granularity) {
+        case Granularity::Week:
+            return 52;
+        case Granularity::Month:
+            return 12;
+        case Granularity::Quarter:
+            return 4;
+        case Granularity::Year:
+            return 1;
+    }
+    return 1;
+}
+
+std::string SpendingTimeSeries::periodLabel(size_t period) const {
+    int key = firstKey + static_cast<int>(period);
+    char buffer[16];
+
+    switch (granularity) {
+        case Granularity::Week:
+            return DateParser::fromDayNumber(key * 7 - 3);
+        case Granularity::Month:
+            snprintf(buffer, sizeof(buffer), "%04d-%02d", key / 12, key % 12 + 1);
+            break;
+        case Granularity::Quarter:
+            snprintf(buffer, sizeof(buffer), "%04d-Q%d", key / 4, key % 4 + 1);
+            break;
+        case Granularity::Year:
+            snprintf(buffer, sizeof(buffer), "%04d", key);
+            break;
+    }
+    return std::string(buffer);
+}
+
+uint32_t SpendingTimeSeries::transactionCount(size_t period) const {
+    return period < counts.size() ? counts[period] : 0;
+}
+
+const double* SpendingTimeSeries::row(const std::string& category) const {
+    if (periods == 0) return nullptr;
+    size_t index = categories.size();
+    if (!category.empty()) {
+        auto it = categoryIndex.find(category);
+        if (it == categoryIndex.end()) return nullptr;
+        index = it->second;
+    }
+    return &prefix[index * (periods + 1)];
+}
+
+double SpendingTimeSeries::periodTotal(size_t period, const std::string& category) const {
+    return rangeTotal(period, period, category);
+}
+
+double SpendingTimeSeries::rangeTotal(size_t first, size_t last,
+                                      const std::string& category) const {
+    const double* p = row(category);
+    if (!p || first > last || first >= periods) return 0.0;
+    last = std::min(last, periods - 1);
+    return p[last + 1] - p[first];
+}
+
+double SpendingTimeSeries::rollingSum(size_t endPeriod, size_t window,
+                                      const std::string& category) const {
+    if (window == 0) return 0.0;
+    size_t first = endPeriod + 1 >= window ? endPeriod + 1 - window : 0;
+    return rangeTotal(first, endPeriod, category);
+}
+
+double SpendingTimeSeries::rollingAverage(size_t endPeriod, size_t window,
+                                          const std::string& category) const {
+    if (window == 0 || endPeriod >= periods) return 0.0;
+    size_t length = std::min(window, endPeriod + 1);
+    return rollingSum(endPeriod, window, category) / length;
+}
+
+double SpendingTimeSeries::periodOverPeriod(size_t period, size_t lag,
+                                            const std::string& category) const {
+    if (lag == 0 || period < lag || period >= periods) return 0.0;
+    double current = periodTotal(period, category);
+    double base = periodTotal(period - lag, category);
+    if (base == 0) return 0.0;
+    return ((current - base) / std::abs(base)) * 100;
+}
+
+double SpendingTimeSeries::yearOverYear(size_t period, const std::string& category) const {
+    return periodOverPeriod(period, periodsPerYear(), category);
+}
@@ -0,0 +1,73 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "TokenIndex.h"
+#include <algorithm>
+
+namespace {
+
+bool isTokenByte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+char lower(unsigned char c) {
+    return static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+}
+
+// Calls visit(token) for each token of text
+template <typename Visit>
+void forEachToken(std::string_view text, std::string& token, Visit visit) {
+    token.clear();
+    for (unsigned char c : text) {
+        if (isTokenByte(c)) {
+            token.push_back(lower(c));
+        } else if (!token.empty()) {
+            visit(token);
+            token.clear();
+        }
+    }
+    if (!token.empty()) visit(token);
+}
+
+} // namespace
+
+void TokenIndex::add(uint32_t row, std::string_view description) {
+    std::string token;
+    forEachToken(description, token, [&](const std::string& t) {
+        auto inserted = tokenIds.emplace(t, static_cast<uint32_t>(tokens.size()));
+        if (inserted.second) {
+            tokens.push_back(t);
+            postings.emplace_back();
+        }
+        std::vector<uint32_t>& rows = postings[inserted.first->second];
+        // A row repeating a token is listed once
+        if (rows.empty() || rows.back() != row) rows.push_back(row);
+    });
+}
+
+void TokenIndex::clear() {
+    tokenIds.clear();
+    tokens.clear();
+    postings.clear();
+}
+
+std::vector<uint32_t> TokenIndex::rowsContaining(std::string_view fragment) const {
+    std::vector<uint32_t> rows;
+    if (fragment.empty()) return rows;
+    for (size_t t = 0; t < tokens.size(); ++t) {
+        if (tokens[t].find(fragment) != std::string::npos) {
+            rows.insert(rows.end(), postings[t].begin(), postings[t].end());
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    return rows;
+}
+
+std::string TokenIndex::longestToken(std::string_view text) {
+    std::string best, token;
+    forEachToken(text, token, [&](const std::string& t) {
+        if (t.size() > best.size()) best = t;
+    });
+    return best;
+}
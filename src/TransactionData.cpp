@@ -18,17 +18,190 @@
 //TransactionData.cpp
 
 #include "TransactionData.h"
+#include "Hashing.h"
+#include "MerchantNormalizer.h"
 #include <algorithm>
+#include <cctype>
+#include <cmath>
 #include <numeric>
 
-TransactionData::TransactionData() {}
+namespace {
+
+// Lowercased alphanumerics with every other run of characters folded to one space, so
+// exports that differ only in case, padding or punctuation fingerprint the same
+std::string normalizeDescription(const std::string& description) {
+    std::string result;
+    result.reserve(description.size());
+    bool separator = false;
+    for (unsigned char c : description) {
+        if (std::isalnum(c)) {
+            if (separator && !result.empty()) result += ' ';
+            result += static_cast<char>(std::tolower(c));
+            separator = false;
+        } else {
+            separator = true;
+        }
+    }
+    return result;
+}
+
+// Keyed on the merchant rather than the raw text, so exports that render the same charge
+// with or without a processor prefix, store number or city still match. Descriptions with no
+// merchant key (e.g. only digits) fall back to the normalized text.
+uint64_t rowFingerprint(const Transaction& t, const std::string& merchant) {
+    uint64_t h = mt::hashBytes(t.accountName);
+    h = mt::combineHash(h, mt::hashBytes(t.date));
+    h = mt::combineHash(h, static_cast<uint64_t>(std::llround(t.statementAmount() * 100.0)));
+    return mt::combineHash(h, mt::hashBytes(merchant.empty() ? normalizeDescription(t.description)
+                                                             : merchant));
+}
+
+} // namespace
+
+TransactionData::TransactionData()
+    : version(0), deduplicate(true), duplicates(0), changeVersion(0) {}
 
 void TransactionData::addTransaction(const Transaction& transaction) {
     transactions.push_back(transaction);
+    transactions.back().merchant = &merchantKey(transaction);
+    indexRows(transactions.size() - 1);
+    ++version;
 }
 
-void TransactionData::addTransactions(const std::vector<Transaction>& trans) {
-    transactions.insert(transactions.end(), trans.begin(), trans.end());
+void TransactionData::indexRows(size_t first) {
+    for (size_t i = first; i < transactions.size(); ++i) {
+        tokenIndex.add(static_cast<uint32_t>(i), transactions[i].description);
+    }
+}
+
+size_t TransactionData::addTransactions(const std::vector<Transaction>& trans) {
+    if (trans.empty()) return 0;
+    
+    size_t before = transactions.size();
+    if (!deduplicate) {
+        transactions.insert(transactions.end(), trans.begin(), trans.end());
+        for (size_t i = before; i < transactions.size(); ++i) {
+            transactions[i].merchant = &merchantKey(transactions[i]);
+        }
+    } else {
+        // The batch set numbers identical rows 0, 1, 2... within this export
+        FingerprintSet batch(trans.size());
+        fingerprints.reserve(fingerprints.size() + trans.size());
+        transactions.reserve(before + trans.size());
+        for (const auto& t : trans) {
+            const std::string& merchant = merchantKey(t);
+            uint64_t base = rowFingerprint(t, merchant);
+            uint64_t ordinal = 0;
+            while (!batch.insert(mt::combineHash(base, ordinal))) ordinal++;
+            
+            if (fingerprints.insert(mt::combineHash(base, ordinal))) {
+                transactions.push_back(t);
+                transactions.back().merchant = &merchant;
+            } else {
+                duplicates++;
+            }
+        }
+    }
+    
+    size_t added = transactions.size() - before;
+    indexRows(before);
+    if (added > 0) ++version;
+    return added;
+}
+
+size_t TransactionData::recategorize(const ConfigManager& config) {
+    std::vector<uint32_t> rows(transactions.size());
+    for (size_t i = 0; i < rows.size(); ++i) rows[i] = static_cast<uint32_t>(i);
+    return applyCategories(rows, config);
+}
+
+size_t TransactionData::recategorize(const ConfigManager& config,
+                                     const CategoryConfig& previous) {
+    std::vector<std::string> keywords;
+    if (!ConfigManager::changedKeywords(previous, config.getConfig(), keywords)) {
+        return recategorize(config);
+    }
+    
+    // A description containing a keyword has a token containing the keyword's longest token
+    std::vector<uint32_t> rows;
+    for (const auto& keyword : keywords) {
+        std::string fragment = TokenIndex::longestToken(keyword);
+        if (fragment.empty()) return recategorize(config);
+        std::vector<uint32_t> matches = tokenIndex.rowsContaining(fragment);
+        rows.insert(rows.end(), matches.begin(), matches.end());
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    return applyCategories(rows, config);
+}
+
+size_t TransactionData::applyCategories(const std::vector<uint32_t>& rows,
+                                        const ConfigManager& config) {
+    std::vector<CategorizationInput> inputs(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const Transaction& t = transactions[rows[i]];
+        inputs[i].description = t.description;
+        inputs[i].amount = t.statementAmount();
+        inputs[i].account = t.accountName;
+        inputs[i].date = t.date;
+        inputs[i].merchant = t.merchant;
+    }
+    std::vector<CategoryId> ids = config.categorizeBatch(inputs);
+    std::vector<std::string> names = config.getCategoryNames();
+    std::vector<std::string> categories(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) categories[i] = names[ids[i]];
+    return assignCategories(rows, categories);
+}
+
+size_t TransactionData::fillUncategorized(const CategoryFallback& fallback,
+                                          const std::string& uncategorized) {
+    std::vector<uint32_t> rows;
+    std::vector<const Transaction*> pending;
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        if (transactions[i].category == uncategorized) {
+            rows.push_back(static_cast<uint32_t>(i));
+            pending.push_back(&transactions[i]);
+        }
+    }
+    std::vector<std::string> suggestions = fallback.suggest(pending);
+    
+    std::vector<uint32_t> filled;
+    std::vector<std::string> categories;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (suggestions[i].empty()) continue;
+        filled.push_back(rows[i]);
+        categories.push_back(std::move(suggestions[i]));
+    }
+    return assignCategories(filled, categories);
+}
+
+size_t TransactionData::assignCategories(const std::vector<uint32_t>& rows,
+                                         const std::vector<std::string>& categories) {
+    std::vector<CategoryChange> changes;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        Transaction& t = transactions[rows[i]];
+        const std::string& category = categories[i];
+        if (t.category != category) {
+            changes.push_back(CategoryChange{rows[i], t.category, category});
+            t.category = category;
+        }
+    }
+    if (!changes.empty()) {
+        ++version;
+        changeLog = std::move(changes);
+        changeVersion = version;
+        return changeLog.size();
+    }
+    return 0;
+}
+
+bool TransactionData::getCategoryChanges(uint64_t sinceVersion,
+                                         std::vector<CategoryChange>& changes) const {
+    if (changeVersion == 0 || changeVersion != version || sinceVersion + 1 != version) {
+        return false;
+    }
+    changes = changeLog;
+    return true;
 }
 
 const std::vector<Transaction>& TransactionData::getAllTransactions() const {
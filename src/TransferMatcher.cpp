@@ -0,0 +1,149 @@
+//Copyright (C) 2026 Matthew Anderson
+//MIT License
+
+#include "TransferMatcher.h"
+#include "CurrencyConverter.h"
+#include "DateParser.h"
+#include "Hashing.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_map>
+
+namespace {
+
+struct Leg {
+    int day;
+    uint32_t account;
+    size_t index;
+};
+
+bool byDay(const Leg& a, const Leg& b) {
+    return a.day != b.day ? a.day < b.day : a.index < b.index;
+}
+
+// Statement currency and statement amount in cents: both legs of a transfer carry the same
+// statement amount, while their converted amounts differ whenever the rate moved in between
+struct AmountKey {
+    uint32_t currency;
+    int64_t cents;
+    
+    bool operator==(const AmountKey& other) const {
+        return currency == other.currency && cents == other.cents;
+    }
+};
+
+struct AmountKeyHash {
+    size_t operator()(const AmountKey& key) const {
+        return static_cast<size_t>(
+            mt::combineHash(key.currency, static_cast<uint64_t>(key.cents)));
+    }
+};
+
+} // namespace
+
+TransferMatcher::TransferMatcher(int windowDays) : windowDays(std::max(0, windowDays)) {}
+
+std::vector<TransferMatch> TransferMatcher::match(const TransactionData& data) const {
+    const auto& transactions = data.getAllTransactions();
+    
+    // Intern accounts and currencies and split rows into dated outflows and inflows
+    std::unordered_map<std::string, uint32_t> accounts;
+    std::unordered_map<std::string, uint32_t> currencies;
+    std::vector<Leg> outflows;
+    std::vector<Leg> inflows;
+    std::vector<AmountKey> outflowKeys;
+    std::vector<AmountKey> inflowKeys;
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        const Transaction& t = transactions[i];
+        int64_t cents = std::llround(t.statementAmount() * 100.0);
+        int day;
+        if (cents == 0 || !DateParser::tryDayNumber(t.date, day)) continue;
+        uint32_t account =
+            accounts.emplace(t.accountName, static_cast<uint32_t>(accounts.size())).first->second;
+        uint32_t currency = currencies.emplace(CurrencyConverter::normalizeCode(t.currency),
+                                               static_cast<uint32_t>(currencies.size()))
+                                .first->second;
+        if (cents < 0) {
+            outflows.push_back({day, account, i});
+            outflowKeys.push_back({currency, -cents});
+        } else {
+            inflows.push_back({day, account, i});
+            inflowKeys.push_back({currency, cents});
+        }
+    }
+    if (accounts.size() < 2 || outflows.empty() || inflows.empty()) return {};
+    
+    // Build: bucket inflows by currency and amount, laid out contiguously (count, offset, fill)
+    std::unordered_map<AmountKey, uint32_t, AmountKeyHash> bucketOf;
+    bucketOf.reserve(inflows.size());
+    std::vector<size_t> bucketStart;
+    std::vector<uint32_t> legBucket(inflows.size());
+    for (size_t i = 0; i < inflows.size(); ++i) {
+        auto it = bucketOf.emplace(inflowKeys[i], static_cast<uint32_t>(bucketStart.size())).first;
+        if (it->second == bucketStart.size()) bucketStart.push_back(0);
+        legBucket[i] = it->second;
+        bucketStart[it->second]++;
+    }
+    size_t offset = 0;
+    for (auto& start : bucketStart) {
+        size_t count = start;
+        start = offset;
+        offset += count;
+    }
+    bucketStart.push_back(offset);
+    
+    std::vector<Leg> table(inflows.size());
+    std::vector<size_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (size_t i = 0; i < inflows.size(); ++i) table[fill[legBucket[i]]++] = inflows[i];
+    for (size_t b = 0; b + 1 < bucketStart.size(); ++b) {
+        std::sort(table.begin() + bucketStart[b], table.begin() + bucketStart[b + 1], byDay);
+    }
+    
+    // Probe: earliest outflows claim first, each taking the nearest unmatched inflow
+    std::vector<size_t> order(outflows.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return byDay(outflows[a], outflows[b]); });
+    std::vector<bool> used(table.size(), false);
+    std::vector<TransferMatch> matches;
+    for (size_t o : order) {
+        const Leg& out = outflows[o];
+        auto it = bucketOf.find(outflowKeys[o]);
+        if (it == bucketOf.end()) continue;
+        
+        auto first = table.begin() + bucketStart[it->second];
+        auto last = table.begin() + bucketStart[it->second + 1];
+        Leg low{out.day - windowDays, 0, 0};
+        auto candidate = std::lower_bound(first, last, low, byDay);
+        
+        size_t best = SIZE_MAX;
+        int bestDistance = INT_MAX;
+        for (; candidate != last && candidate->day <= out.day + windowDays; ++candidate) {
+            size_t slot = static_cast<size_t>(candidate - table.begin());
+            if (used[slot] || candidate->account == out.account) continue;
+            int distance = std::abs(candidate->day - out.day);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = slot;
+            }
+        }
+        if (best == SIZE_MAX) continue;
+        
+        used[best] = true;
+        matches.push_back({out.index, table[best].index, table[best].day - out.day});
+    }
+    return matches;
+}
+
+std::vector<bool> TransferMatcher::matchedRows(const std::vector<TransferMatch>& matches,
+                                               size_t rows) {
+    std::vector<bool> mask(rows, false);
+    for (const auto& match : matches) {
+        mask[match.outflow] = true;
+        mask[match.inflow] = true;
+    }
+    return mask;
+}
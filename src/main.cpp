@@ -6,14 +6,21 @@
 #include <string>
 #include <memory>
 #include <iomanip>
+#include <map>
+#include <cmath>
+#include <algorithm>
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
 #include "CSVParser.h"
 #include "TransactionData.h"
 #include "BudgetAnalyzer.h"
+#include "BudgetSimulator.h"
 #include "SpreadsheetGenerator.h"
 #include "ConfigManager.h"
+#include "CurrencyConverter.h"
 #include "AlertSystem.h"
+#include "FuzzyMatcher.h"
+#include "NaiveBayesClassifier.h"
 
 namespace po = boost::program_options;
 namespace fs = boost::filesystem;
@@ -65,6 +72,36 @@ int main(int argc, char* argv[]) {
              "CSV format: auto, bank, or generic (default: auto)")
             ("category-config", po::value<std::string>(),
              "path to custom categories.json file")
+            ("anomaly-sigma", po::value<double>()->default_value(5.0),
+             "flag charges this many standard deviations above their category/merchant norm")
+            ("overall-limit", po::value<double>(),
+             "monthly overall spending limit")
+            ("category-limit", po::value<std::vector<std::string>>(),
+             "monthly category limit as CATEGORY=AMOUNT (repeatable; paths cover subcategories)")
+            ("simulate", po::value<size_t>()->default_value(10000),
+             "Monte Carlo months to simulate against the limits (0 disables)")
+            ("transfer-window", po::value<int>()->default_value(3),
+             "max days between the two sides of an own-account transfer (-1 disables matching)")
+            ("currency", po::value<std::vector<std::string>>(),
+             "ISO currency code of each input file (defaults to the reporting currency)")
+            ("reporting-currency", po::value<std::string>()->default_value("USD"),
+             "currency all totals are converted to")
+            ("fx-rates", po::value<std::string>(),
+             "CSV of date,currency,rate (reporting-currency units per foreign unit)")
+            ("merchant-dictionary", po::value<std::string>(),
+             "CSV of merchant,category used to fuzzy-match uncategorized transactions")
+            ("fuzzy-threshold", po::value<double>()->default_value(FuzzyMatcher::kDefaultThreshold),
+             "trigram similarity (0-1] an uncategorized merchant needs to a known one (0 disables)")
+            ("train-model", po::value<std::string>(),
+             "train a category model on this run's categorized transactions, save it here and "
+             "apply it")
+            ("category-model", po::value<std::string>(),
+             "category model used to categorize what the rules and fuzzy matching missed")
+            ("model-confidence",
+             po::value<double>()->default_value(NaiveBayesClassifier::kDefaultConfidence),
+             "minimum probability for the category model to categorize a transaction")
+            ("forecast", po::value<size_t>()->default_value(3),
+             "months of per-category spending to forecast (0 disables, max 24)")
             ("verbose,v", "verbose output")
             ("no-spreadsheet", "skip Excel spreadsheet generation (console output only)");
         
@@ -106,6 +143,7 @@ int main(int argc, char* argv[]) {
         std::string outputFile = vm["output"].as<std::string>();
         bool verbose = vm.count("verbose") > 0;
         bool generateSpreadsheet = !vm.count("no-spreadsheet");
+        size_t forecastMonths = vm["forecast"].as<size_t>();
         
         // Validate output directory is writable
         if (generateSpreadsheet && !isDirectoryWritable(outputFile)) {
@@ -151,12 +189,57 @@ int main(int argc, char* argv[]) {
                 configManager->loadCategoriesFromFile(defaultConfig);
             }
         }
+        if (verbose && configManager->loadedFromRuleCache()) {
+            std::cout << "  Using compiled rule cache" << std::endl;
+        }
+        
+        // ==================== CURRENCIES ====================
+        CurrencyConverter converter(vm["reporting-currency"].as<std::string>());
+        std::string currencySymbol = CurrencyConverter::symbol(converter.getReportingCurrency());
+        auto currencies = vm.count("currency") ? vm["currency"].as<std::vector<std::string>>()
+                                               : std::vector<std::string>();
+        currencies.resize(inputFiles.size(), converter.getReportingCurrency());
+        
+        if (vm.count("fx-rates")) {
+            converter.loadRates(vm["fx-rates"].as<std::string>());
+        }
+        for (const auto& currency : currencies) {
+            if (!converter.hasRates(currency)) {
+                std::cerr << "Error: No FX rates for " << currency << " (use --fx-rates)"
+                         << std::endl;
+                return 1;
+            }
+        }
         
         // ==================== PARSE CSV FILES ====================
         TransactionData allData;
         CSVParser parser(configManager);
         
+        // Screen charges for anomalies as each file is loaded, in the reporting currency
+        AlertSystem alertSystem;
+        alertSystem.setReportingCurrency(converter.getReportingCurrency());
+        alertSystem.setAnomalyThreshold(vm["anomaly-sigma"].as<double>());
+        alertSystem.setAlertCallback([](const Alert& alert) {
+            std::cout << "  WARNING: " << alert.message << std::endl;
+        });
+        if (vm.count("overall-limit")) {
+            alertSystem.setOverallLimit(vm["overall-limit"].as<double>());
+        }
+        if (vm.count("category-limit")) {
+            for (const auto& spec : vm["category-limit"].as<std::vector<std::string>>()) {
+                size_t split = spec.rfind('=');
+                if (split == std::string::npos || split == 0) {
+                    std::cerr << "Error: --category-limit expects CATEGORY=AMOUNT, got '"
+                             << spec << "'" << std::endl;
+                    return 1;
+                }
+                alertSystem.setCategoryLimit(spec.substr(0, split),
+                                             std::stod(spec.substr(split + 1)));
+            }
+        }
+        
         int totalTransactions = 0;
+        std::vector<size_t> unscreened;
         for (size_t i = 0; i < inputFiles.size(); ++i) {
             if (verbose) {
                 std::cout << "Processing: " << inputFiles[i] 
@@ -174,11 +257,32 @@ int main(int argc, char* argv[]) {
                     transactions = parser.parse(inputFiles[i], accountNames[i]);
                 }
                 
-                allData.addTransactions(transactions);
-                totalTransactions += transactions.size();
+                for (auto& transaction : transactions) {
+                    transaction.currency = currencies[i];
+                }
+                converter.convert(transactions);
+                
+                size_t added = allData.addTransactions(transactions);
+                totalTransactions += added;
+                // Rows already imported from an overlapping file were screened the first time.
+                // Rows the rules left in "Other" wait for the fallback fill below, so their
+                // charges count towards the category they end up in.
+                const auto& loaded = allData.getAllTransactions();
+                for (size_t row = loaded.size() - added; row < loaded.size(); ++row) {
+                    if (loaded[row].category == "Other") {
+                        unscreened.push_back(row);
+                    } else {
+                        alertSystem.observeTransaction(loaded[row]);
+                    }
+                }
                 
                 if (verbose) {
-                    std::cout << "  OK Loaded " << transactions.size() << " transactions" << std::endl;
+                    std::cout << "  OK Loaded " << added << " transactions";
+                    if (added < transactions.size()) {
+                        std::cout << " (" << transactions.size() - added
+                                 << " already imported from an overlapping file)";
+                    }
+                    std::cout << std::endl;
                 }
             } catch (const std::exception& e) {
                 std::cerr << "Error processing " << inputFiles[i] << ": " << e.what() << std::endl;
@@ -187,7 +291,15 @@ int main(int argc, char* argv[]) {
         }
         
         if (verbose) {
-            std::cout << "\nTotal transactions loaded: " << totalTransactions << std::endl << std::endl;
+            CategoryCacheStats cacheStats = configManager->getCacheStats();
+            std::cout << "\nTotal transactions loaded: " << totalTransactions << std::endl;
+            std::cout << "Categorization cache: " << cacheStats.hits << " hits, "
+                     << cacheStats.misses << " misses, " << cacheStats.entries
+                     << " distinct descriptions" << std::endl << std::endl;
+        }
+        if (allData.getDuplicateCount() > 0) {
+            std::cout << "Merged " << allData.getDuplicateCount()
+                     << " duplicate transaction(s) from overlapping statements" << std::endl;
         }
         
         if (totalTransactions == 0) {
@@ -195,41 +307,208 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         
+        // ==================== FALLBACK CATEGORIZATION ====================
+        // Train before any fallback runs, so the model only learns from the rules' answers
+        NaiveBayesClassifier model;
+        model.setConfidence(vm["model-confidence"].as<double>());
+        if (vm.count("train-model")) {
+            std::string modelPath = vm["train-model"].as<std::string>();
+            size_t trained = model.train(allData);
+            if (!model.isTrained()) {
+                std::cerr << "Warning: Category model not trained: the categorized rows span "
+                         << "fewer than two categories" << std::endl;
+            } else {
+                model.save(modelPath);
+                if (verbose) {
+                    std::cout << "Trained category model on " << trained
+                             << " transaction(s) in " << model.getCategories().size()
+                             << " categories: " << modelPath << std::endl;
+                }
+            }
+        }
+        if (vm.count("category-model") &&
+            !model.load(vm["category-model"].as<std::string>())) {
+            std::cerr << "Warning: Category model not loaded: "
+                     << vm["category-model"].as<std::string>() << std::endl;
+        }
+        
+        // Match merchants the rules missed against the dictionary and the categorized history
+        double fuzzyThreshold = vm["fuzzy-threshold"].as<double>();
+        if (fuzzyThreshold > 0) {
+            FuzzyMatcher matcher(std::min(fuzzyThreshold, 1.0));
+            if (vm.count("merchant-dictionary")) {
+                matcher.loadDictionary(vm["merchant-dictionary"].as<std::string>());
+            }
+            matcher.addHistory(allData);
+            matcher.build();
+            size_t filled = allData.fillUncategorized(matcher);
+            if (verbose) {
+                std::cout << "Fuzzy merchant matching categorized " << filled
+                         << " transaction(s) against " << matcher.size() << " known merchants"
+                         << std::endl << std::endl;
+            }
+        }
+        if (model.isTrained()) {
+            size_t filled = allData.fillUncategorized(model);
+            if (verbose) {
+                std::cout << "Category model categorized " << filled << " transaction(s)"
+                         << std::endl << std::endl;
+            }
+        }
+        
+        const auto& loaded = allData.getAllTransactions();
+        for (size_t row : unscreened) {
+            alertSystem.observeTransaction(loaded[row]);
+        }
+        
         // ==================== ANALYZE BUDGET ====================
         BudgetAnalyzer analyzer(allData);
+        analyzer.setTransferMatchWindow(vm["transfer-window"].as<int>());
         BudgetSummary summary = analyzer.analyzeBudget();
         
         // ==================== DISPLAY CONSOLE OUTPUT ====================
         std::cout << "=== BUDGET SUMMARY ===" << std::endl;
-        std::cout << "Total Income:    $" << std::fixed << std::setprecision(2) 
+        std::cout << "Total Income:    " << currencySymbol << std::fixed << std::setprecision(2) 
                  << summary.totalIncome << std::endl;
-        std::cout << "Total Expenses:  $" << summary.totalExpenses << std::endl;
-        std::cout << "Net Change:      $" << summary.netChange << std::endl;
+        std::cout << "Total Expenses:  " << currencySymbol << summary.totalExpenses << std::endl;
+        std::cout << "Net Change:      " << currencySymbol << summary.netChange << std::endl;
+        std::cout << "Distinct Merchants: ~" << std::setprecision(0) << summary.distinctMerchants
+                 << std::setprecision(2) << std::endl;
+        if (summary.matchedTransfers > 0) {
+            std::cout << "Transfers Excluded: " << summary.matchedTransfers << " (" << currencySymbol
+                     << summary.transferVolume << ")" << std::endl;
+        }
         
         std::cout << "\n=== SPENDING BY CATEGORY ===" << std::endl;
         for (const auto& cat : summary.categoryBreakdown) {
             std::cout << "  " << std::setw(20) << std::left << cat.first 
-                     << ": $" << std::setw(10) << std::right << std::fixed << std::setprecision(2)
+                     << ": " << currencySymbol << std::setw(10) << std::right << std::fixed << std::setprecision(2)
                      << cat.second << std::endl;
         }
         
         std::cout << "\n=== MONTHLY TRENDS ===" << std::endl;
         for (const auto& month : summary.monthlyTrends) {
-            std::cout << "  " << month.first << ": $" << std::fixed << std::setprecision(2) 
+            std::cout << "  " << month.first << ": " << currencySymbol << std::fixed << std::setprecision(2) 
                      << month.second << std::endl;
         }
         
+        if (forecastMonths > 0) {
+            ForecastResult forecast = analyzer.getSpendingForecast(forecastMonths);
+            std::map<std::string, std::vector<double>> byCategory;
+            for (const auto& group : forecast.groups) {
+                auto& values = byCategory[group.category];
+                values.resize(group.values.size(), 0.0);
+                for (size_t m = 0; m < group.values.size(); ++m) {
+                    values[m] += group.values[m];
+                }
+            }
+            
+            std::cout << "\n=== SPENDING FORECAST ===" << std::endl;
+            std::cout << "  " << std::setw(20) << std::left << "Category" << std::right;
+            for (const auto& month : forecast.months) {
+                std::cout << std::setw(12) << month;
+            }
+            std::cout << std::endl;
+            for (const auto& category : byCategory) {
+                std::cout << "  " << std::setw(20) << std::left << category.first << std::right;
+                for (double value : category.second) {
+                    std::cout << std::setw(12) << value;
+                }
+                std::cout << std::endl;
+            }
+        }
+        
+        size_t simulations = vm["simulate"].as<size_t>();
+        bool hasLimits =
+            alertSystem.getOverallLimit() > 0 || !alertSystem.getCategoryLimits().empty();
+        if (simulations > 0 && hasLimits) {
+            SimulationResult simulation =
+                BudgetSimulator(simulations).run(*analyzer.getDataCube(), alertSystem);
+            
+            std::cout << "\n=== BUDGET SIMULATION (" << simulation.scenarios
+                     << " simulated months, " << simulation.historyMonths
+                     << " months of history) ===" << std::endl;
+            for (const auto& outlook : simulation.outlooks) {
+                if (outlook.limit <= 0) continue;
+                std::cout << "  " << std::setw(20) << std::left << outlook.category << std::right
+                         << " limit " << currencySymbol << outlook.limit
+                         << "  P(exceed) " << outlook.exceedanceProbability * 100.0 << "%"
+                         << "  median " << currencySymbol << outlook.median << ", p90 " << currencySymbol << outlook.p90
+                         << ", p99 " << currencySymbol << outlook.p99 << std::endl;
+            }
+        }
+        
         if (verbose) {
+            std::cout << "\n=== DISTINCT MERCHANTS BY MONTH ===" << std::endl;
+            for (const auto& month : analyzer.getDistinctMerchants().byMonth) {
+                std::cout << "  " << month.first << ": ~" << std::setprecision(0) << month.second
+                         << std::setprecision(2) << std::endl;
+            }
+            
+            std::cout << "\n=== RECURRING PAYMENTS ===" << std::endl;
+            for (const auto& series : analyzer.getRecurringPayments()) {
+                if (!series.active) continue;
+                std::cout << "  " << std::setw(24) << std::left << series.merchant << std::right
+                         << " " << RecurringDetector::periodName(series.period)
+                         << " " << currencySymbol << series.nextExpectedAmount
+                         << " next on " << series.nextExpectedDate << std::endl;
+            }
+            
+            // Balances stay in each account's statement currency
+            auto accountSymbol = [&](const std::string& currency) {
+                return CurrencyConverter::symbol(currency.empty() ? converter.getReportingCurrency()
+                                                                  : currency);
+            };
+            
+            std::cout << "\n=== RECONCILIATION ===" << std::endl;
+            for (const auto& account : analyzer.getReconciliation()) {
+                std::string symbol = accountSymbol(account.currency);
+                std::cout << "  " << account.accountName << ": " << account.transactions
+                         << " transactions, " << account.flags.size() << " issue(s)";
+                if (account.hasBalances) {
+                    std::cout << ", opening " << symbol << account.openingBalance
+                             << ", closing " << symbol << account.closingBalance;
+                }
+                std::cout << std::endl;
+                for (const auto& flag : account.flags) {
+                    std::cout << "    " << Reconciler::issueName(flag.issue) << " on " << flag.date
+                             << ": " << flag.description;
+                    if (flag.amount != 0.0) std::cout << " (" << symbol << flag.amount << ")";
+                    std::cout << std::endl;
+                }
+            }
+            
+            std::cout << "\n=== CASH FLOW PROJECTION (90 days) ===" << std::endl;
+            for (const auto& projection : analyzer.getCashFlowProjection()) {
+                std::string symbol = accountSymbol(projection.currency);
+                double ending = projection.points.empty() ? projection.startingBalance
+                                                          : projection.points.back().balance;
+                std::cout << "  " << projection.accountName << ": " << symbol
+                         << projection.startingBalance << " -> " << symbol << ending << " (low "
+                         << symbol << projection.lowestBalance << " on "
+                         << projection.lowestDate << ")" << std::endl;
+            }
+            
             std::cout << "\n=== ACCOUNT BREAKDOWN ===" << std::endl;
             for (const auto& account : summary.accountBreakdown) {
-                std::cout << "  " << account.first << ": $" << std::fixed << std::setprecision(2)
+                std::cout << "  " << account.first << ": " << currencySymbol << std::fixed << std::setprecision(2)
                          << account.second << std::endl;
             }
             
             std::cout << "\n=== STATISTICS ===" << std::endl;
             std::cout << "Total Transactions: " << totalTransactions << std::endl;
-            std::cout << "Average Transaction: $" << analyzer.getAverageTransaction() << std::endl;
-            std::cout << "Average Monthly Spending: $" << analyzer.getAverageMonthlySpending() << std::endl;
+            std::cout << "Average Transaction: " << currencySymbol << analyzer.getAverageTransaction() << std::endl;
+            std::cout << "Average Monthly Spending: " << currencySymbol << analyzer.getAverageMonthlySpending() << std::endl;
+            for (size_t window : {3, 6, 12}) {
+                std::cout << window << "-Month Rolling Average: " << currencySymbol
+                         << std::abs(analyzer.getRollingAverageSpending(window)) << std::endl;
+            }
+            std::cout << "Month-over-Month Change: " << analyzer.getMonthOverMonthChange() << "%" << std::endl;
+            std::cout << "Year-over-Year Change: " << analyzer.getYearOverYearChange() << "%" << std::endl;
+            
+            SizeDistribution sizes = analyzer.getSizeDistributions().overall;
+            std::cout << "Transaction Size: median " << currencySymbol << sizes.median << ", p90 " << currencySymbol << sizes.p90
+                     << ", p99 " << currencySymbol << sizes.p99 << std::endl;
         }
         
         // ==================== GENERATE SPREADSHEET ====================
@@ -240,6 +519,8 @@ int main(int argc, char* argv[]) {
             
             try {
                 SpreadsheetGenerator generator;
+                generator.setReportingCurrency(converter.getReportingCurrency());
+                generator.setForecastMonths(forecastMonths);
                 if (!generator.generateSpreadsheet(allData, analyzer, outputFile)) {
                     std::cerr << "Error: Failed to generate spreadsheet" << std::endl;
                     return 1;
@@ -0,0 +1,490 @@
+// GoogleTest unit tests for BudgetAnalyzer and AlertSystem
+#include <gtest/gtest.h>
+#include "AlertSystem.h"
+#include "BudgetAnalyzer.h"
+#include "BudgetSimulator.h"
+#include "CurrencyConverter.h"
+#include "Reconciler.h"
+
+static Transaction makeTransaction(const std::string& date, const std::string& category,
+                                   double amount, const std::string& account = "Checking") {
+    Transaction t;
+    t.date = date;
+    t.description = category;
+    t.category = category;
+    t.amount = amount;
+    t.accountName = account;
+    return t;
+}
+
+TEST(BudgetAnalyzerTest, SummaryTotals) {
+    TransactionData data;
+    data.addTransaction(makeTransaction("2024-01-05", "Groceries", -50.0));
+    data.addTransaction(makeTransaction("2024-01-06", "Income", 1000.0));
+    data.addTransaction(makeTransaction("2024-02-01", "Gas", -30.0, "Savings"));
+    
+    BudgetAnalyzer analyzer(data);
+    BudgetSummary summary = analyzer.analyzeBudget();
+    
+    EXPECT_DOUBLE_EQ(summary.totalIncome, 1000.0);
+    EXPECT_DOUBLE_EQ(summary.totalExpenses, 80.0);
+    EXPECT_DOUBLE_EQ(summary.accountBreakdown["Checking"], -50.0);
+    EXPECT_DOUBLE_EQ(summary.accountBreakdown["Savings"], -30.0);
+    EXPECT_DOUBLE_EQ(summary.monthlyTrends["2024-02"], -30.0);
+}
+
+TEST(BudgetAnalyzerTest, VersionBumpsOnMutation) {
+    TransactionData data;
+    uint64_t initial = data.getVersion();
+    data.addTransaction(makeTransaction("2024-01-05", "Groceries", -50.0));
+    EXPECT_GT(data.getVersion(), initial);
+    
+    uint64_t afterAdd = data.getVersion();
+    data.addTransactions({});
+    EXPECT_EQ(data.getVersion(), afterAdd);
+}
+
+TEST(BudgetAnalyzerTest, DropsRowsRepeatedByOverlappingExports) {
+    std::vector<Transaction> january = {
+        makeTransaction("2024-01-30", "Coffee", -4.5),
+        makeTransaction("2024-01-30", "Coffee", -4.5),  // Two genuine coffees that day
+        makeTransaction("2024-01-31", "Rent", -1200.0),
+    };
+    std::vector<Transaction> february = {
+        makeTransaction("2024-01-30", "Coffee", -4.5),
+        makeTransaction("2024-01-30", "Coffee", -4.5),
+        makeTransaction("2024-01-31", "RENT ", -1200.0),  // Re-exported with other padding
+        makeTransaction("2024-01-31", "Rent", -1200.0, "Savings"),
+        makeTransaction("2024-02-01", "Coffee", -4.5),
+    };
+    
+    TransactionData data;
+    EXPECT_EQ(data.addTransactions(january), 3u);
+    EXPECT_EQ(data.addTransactions(february), 2u);
+    EXPECT_EQ(data.getAllTransactions().size(), 5u);
+    EXPECT_EQ(data.getDuplicateCount(), 3u);
+    EXPECT_EQ(data.getAllTransactions()[3].accountName, "Savings");
+    EXPECT_EQ(data.getAllTransactions()[4].date, "2024-02-01");
+    
+    // A third coffee on the 30th in a later export is new
+    EXPECT_EQ(data.addTransactions(std::vector<Transaction>(3, january[0])), 1u);
+}
+
+TEST(BudgetAnalyzerTest, CacheInvalidatesWhenDataChanges) {
+    TransactionData data;
+    data.addTransaction(makeTransaction("2024-01-05", "Groceries", -50.0));
+    
+    BudgetAnalyzer analyzer(data);
+    EXPECT_DOUBLE_EQ(analyzer.getCategoryAnalysis()["Groceries"], -50.0);
+    EXPECT_DOUBLE_EQ(analyzer.analyzeBudget().totalExpenses, 50.0);
+    
+    data.addTransaction(makeTransaction("2024-01-07", "Groceries", -25.0));
+    EXPECT_DOUBLE_EQ(analyzer.getCategoryAnalysis()["Groceries"], -75.0);
+    EXPECT_DOUBLE_EQ(analyzer.analyzeBudget().totalExpenses, 75.0);
+}
+
+TEST(BudgetAnalyzerTest, RollingWindowsAndPeriodOverPeriod) {
+    TransactionData data;
+    data.addTransaction(makeTransaction("2023-03-10", "Dining", -40.0));
+    data.addTransaction(makeTransaction("2024-01-10", "Dining", -100.0));
+    data.addTransaction(makeTransaction("2024-02-10", "Dining", -50.0));
+    data.addTransaction(makeTransaction("2024-03-10", "Dining", -60.0));
+    data.addTransaction(makeTransaction("2024-03-11", "Gas", -20.0));
+    data.addTransaction(makeTransaction("2024-3-1", "Gas", -999.0));  // Malformed, skipped
+    
+    BudgetAnalyzer analyzer(data);
+    auto series = analyzer.getTimeSeries(Granularity::Month);
+    ASSERT_EQ(series->periodCount(), 13u);  // 2023-03 .. 2024-03 with no gaps
+    EXPECT_EQ(series->periodLabel(12), "2024-03");
+    EXPECT_EQ(series->activePeriodCount(), 4u);
+    
+    EXPECT_DOUBLE_EQ(analyzer.getRollingSpending(3), -230.0);
+    EXPECT_DOUBLE_EQ(analyzer.getRollingAverageSpending(3, "Dining"), -70.0);
+    // Signed totals: more spending reads as a negative change, like getSpendingTrend
+    EXPECT_DOUBLE_EQ(analyzer.getMonthOverMonthChange("Dining"), -20.0);
+    EXPECT_DOUBLE_EQ(analyzer.getYearOverYearChange("Dining"), -50.0);
+    
+    auto quarters = analyzer.getTimeSeries(Granularity::Quarter);
+    EXPECT_EQ(quarters->periodLabel(quarters->periodCount() - 1), "2024-Q1");
+    EXPECT_DOUBLE_EQ(quarters->periodTotal(quarters->periodCount() - 1), -230.0);
+}
+
+TEST(BudgetAnalyzerTest, SizeDistributionsAcrossChunks) {
+    TransactionData data;
+    std::vector<Transaction> batch;
+    for (int i = 1; i <= 150000; ++i) {
+        batch.push_back(makeTransaction("2024-01-15", i % 2 ? "Dining" : "Gas", -(i % 1000 + 1.0)));
+    }
+    data.addTransactions(batch);
+    
+    BudgetAnalyzer analyzer(data);
+    SizeDistributions sizes = analyzer.getSizeDistributions();
+    EXPECT_EQ(sizes.overall.count, 150000u);
+    EXPECT_NEAR(sizes.overall.median, 500.0, 20.0);
+    EXPECT_NEAR(sizes.overall.p90, 900.0, 20.0);
+    EXPECT_EQ(sizes.byCategory["Dining"].count, 75000u);
+    EXPECT_EQ(sizes.byMonth["2024-01"].count, 150000u);
+}
+
+TEST(BudgetAnalyzerTest, DetectsMonthlySubscription) {
+    TransactionData data;
+    const char* dates[] = {"2024-01-31", "2024-02-29", "2024-03-31", "2024-04-30"};
+    for (const char* date : dates) {
+        Transaction t = makeTransaction(date, "Entertainment", -15.49);
+        t.description = "NETFLIX.COM 866-579-7172";
+        data.addTransaction(t);
+    }
+    data.addTransaction(makeTransaction("2024-02-03", "Dining", -12.0));
+    data.addTransaction(makeTransaction("2024-03-19", "Dining", -31.0));
+    
+    BudgetAnalyzer analyzer(data);
+    auto recurring = analyzer.getRecurringPayments();
+    ASSERT_EQ(recurring.size(), 1u);
+    EXPECT_EQ(recurring[0].merchant, "netflix com");
+    EXPECT_EQ(recurring[0].period, RecurrencePeriod::Monthly);
+    EXPECT_EQ(recurring[0].occurrences, 4u);
+    EXPECT_EQ(recurring[0].nextExpectedDate, "2024-05-30");
+    EXPECT_DOUBLE_EQ(recurring[0].nextExpectedAmount, -15.49);
+    EXPECT_TRUE(recurring[0].active);
+}
+
+TEST(BudgetAnalyzerTest, KeepsSeriesTogetherAcrossAmountBandEdges) {
+    // 10.80 and 10.87 sit either side of 1.1^25, where fixed 10% log bands used to split
+    TransactionData data;
+    const char* dates[] = {"2024-01-15", "2024-02-15", "2024-03-15", "2024-04-15"};
+    for (int i = 0; i < 4; ++i) {
+        Transaction t = makeTransaction(dates[i], "Entertainment", i % 2 ? -10.87 : -10.80);
+        t.description = "SPOTIFY USA";
+        data.addTransaction(t);
+    }
+    // Same merchant, a different price tier: not part of the series
+    Transaction upgrade = makeTransaction("2024-03-02", "Entertainment", -16.99);
+    upgrade.description = "SPOTIFY USA";
+    data.addTransaction(upgrade);
+    
+    BudgetAnalyzer analyzer(data);
+    auto recurring = analyzer.getRecurringPayments();
+    ASSERT_EQ(recurring.size(), 1u);
+    EXPECT_EQ(recurring[0].period, RecurrencePeriod::Monthly);
+    EXPECT_EQ(recurring[0].occurrences, 4u);
+}
+
+TEST(DataCubeTest, RollUpsPivotsAndSlices) {
+    TransactionData data;
+    data.addTransaction(makeTransaction("2024-01-05", "Groceries", -50.0));
+    data.addTransaction(makeTransaction("2024-03-07", "Groceries", -20.0, "Savings"));
+    data.addTransaction(makeTransaction("2024-03-09", "Gas", -30.0));
+    data.addTransaction(makeTransaction("2024-03-10", "Income", 900.0));
+    data.addTransaction(makeTransaction("not a date", "Gas", -5.0, "Savings"));
+    
+    DataCube cube(data);
+    ASSERT_EQ(cube.size(CubeAxis::Period), 3u);  // February is kept as an empty month
+    EXPECT_EQ(cube.labels(CubeAxis::Category)[0], "Gas");
+    EXPECT_EQ(cube.find(CubeAxis::Account, "Brokerage"), DataCube::npos);
+    
+    CubeCell total = cube.total();
+    EXPECT_DOUBLE_EQ(total.spending, -105.0);
+    EXPECT_DOUBLE_EQ(total.income, 900.0);
+    EXPECT_EQ(total.count, 5u);
+    
+    size_t gas = cube.find(CubeAxis::Category, "Gas");
+    size_t groceries = cube.find(CubeAxis::Category, "Groceries");
+    size_t savings = cube.find(CubeAxis::Account, "Savings");
+    size_t march = cube.find(CubeAxis::Period, "2024-03");
+    
+    // Undated rows count toward categories but not months
+    EXPECT_DOUBLE_EQ(cube.rollUp(CubeAxis::Category)[gas].spending, -35.0);
+    EXPECT_DOUBLE_EQ(cube.rollUp(CubeAxis::Period)[march].spending, -50.0);
+    
+    std::vector<CubeCell> pivot = cube.pivot(CubeAxis::Category, CubeAxis::Account);
+    EXPECT_DOUBLE_EQ(pivot[groceries * 2 + savings].spending, -20.0);
+    
+    std::vector<CubeCell> slice =
+        cube.slice(CubeAxis::Period, march, CubeAxis::Category, CubeAxis::Account);
+    EXPECT_DOUBLE_EQ(slice[gas * 2 + savings].spending, 0.0);
+    EXPECT_DOUBLE_EQ(slice[groceries * 2 + savings].spending, -20.0);
+    EXPECT_THROW(cube.pivot(CubeAxis::Account, CubeAxis::Account), std::invalid_argument);
+}
+
+TEST(DataCubeTest, PatchesRecategorizedRowsLikeARebuild) {
+    TransactionData data;
+    data.addTransaction(makeTransaction("2024-01-05", "Groceries", -50.0));
+    data.addTransaction(makeTransaction("2024-03-07", "Groceries", -20.0, "Savings"));
+    data.addTransaction(makeTransaction("2024-03-09", "Gas", -30.0));
+    data.addTransaction(makeTransaction("2024-03-10", "Income", 900.0));
+    data.addTransaction(makeTransaction("not a date", "Gas", -5.0, "Savings"));
+    DataCube cube(data);
+    
+    TransactionData moved;
+    for (auto t : data.getAllTransactions()) {
+        if (t.amount == -20.0 || t.amount == -5.0) t.category = "Gas";
+        if (t.amount == -30.0) t.category = "Groceries";
+        moved.addTransaction(t);
+    }
+    std::vector<CategoryChange> changes = {{1, "Groceries", "Gas"}, {2, "Gas", "Groceries"}};
+    auto patched = cube.withCategoryChanges(moved, changes);
+    ASSERT_NE(patched, nullptr);
+    DataCube rebuilt(moved);
+    for (size_t c = 0; c < rebuilt.size(CubeAxis::Category); ++c) {
+        for (size_t a = 0; a < rebuilt.size(CubeAxis::Account); ++a) {
+            for (size_t p = 0; p < rebuilt.size(CubeAxis::Period); ++p) {
+                EXPECT_DOUBLE_EQ(patched->cell(c, a, p).spending, rebuilt.cell(c, a, p).spending);
+                EXPECT_EQ(patched->cell(c, a, p).count, rebuilt.cell(c, a, p).count);
+            }
+        }
+    }
+    
+    // New or emptied categories change the axis, so the patch declines
+    EXPECT_EQ(cube.withCategoryChanges(moved, {{1, "Groceries", "Travel"}}), nullptr);
+    EXPECT_EQ(cube.withCategoryChanges(moved, {{3, "Income", "Gas"}}), nullptr);
+}
+
+TEST(BudgetAnalyzerTest, RollsCategoryTreeUp) {
+    TransactionData data;
+    data.addTransaction(makeTransaction("2024-01-05", "Food/Groceries", -80.0));
+    data.addTransaction(makeTransaction("2024-01-06", "Food/Dining/Coffee", -5.0));
+    data.addTransaction(makeTransaction("2024-01-07", "Food/Dining", -40.0));
+    data.addTransaction(makeTransaction("2024-01-08", " Food / Dining / Coffee ", -3.0));
+    data.addTransaction(makeTransaction("2024-01-09", "Gas", -30.0));
+    
+    BudgetAnalyzer analyzer(data);
+    EXPECT_DOUBLE_EQ(analyzer.getCategoryTotal("Food"), -128.0);
+    EXPECT_DOUBLE_EQ(analyzer.getCategoryTotal("Food/Dining"), -48.0);
+    EXPECT_DOUBLE_EQ(analyzer.getCategoryTotal("Food/Dining/Coffee"), -8.0);
+    EXPECT_DOUBLE_EQ(analyzer.getCategoryTotal("Travel"), 0.0);
+    
+    auto tree = analyzer.getCategoryTree();
+    const auto& nodes = tree->getNodes();
+    const CategoryNode& dining = nodes[tree->find("Food/Dining")];
+    EXPECT_DOUBLE_EQ(dining.direct.spending, -40.0);
+    EXPECT_EQ(dining.depth, 1);
+    EXPECT_EQ(dining.total.count, 3u);
+    
+    std::vector<std::string> order;
+    for (size_t id : tree->preOrder()) order.push_back(nodes[id].path);
+    std::vector<std::string> expected = {"Food", "Food/Dining", "Food/Dining/Coffee",
+                                         "Food/Groceries", "Gas"};
+    EXPECT_EQ(order, expected);
+}
+
+TEST(BudgetAnalyzerTest, ForecastsSeasonalAndTrendingSpend) {
+    TransactionData data;
+    char date[16];
+    for (int m = 0; m < 36; ++m) {
+        snprintf(date, sizeof(date), "%04d-%02d-10", 2021 + m / 12, m % 12 + 1);
+        // December spikes every year; rent climbs by $10 a month
+        data.addTransaction(makeTransaction(date, "Gifts", m % 12 == 11 ? -500.0 : -50.0));
+        data.addTransaction(makeTransaction(date, "Rent", -1000.0 - 10.0 * m));
+    }
+    
+    BudgetAnalyzer analyzer(data);
+    ForecastResult forecast = analyzer.getSpendingForecast(12);
+    ASSERT_EQ(forecast.months.size(), 12u);
+    EXPECT_EQ(forecast.months.front(), "2024-01");
+    ASSERT_EQ(forecast.groups.size(), 2u);
+    
+    const SpendingForecast& gifts = forecast.groups[0];
+    EXPECT_EQ(gifts.category, "Gifts");
+    EXPECT_EQ(gifts.method, "Holt-Winters");
+    EXPECT_NEAR(gifts.values[0], 50.0, 25.0);
+    EXPECT_NEAR(gifts.values[11], 500.0, 50.0);
+    
+    const SpendingForecast& rent = forecast.groups[1];
+    EXPECT_NEAR(rent.values[0], 1360.0, 20.0);
+    EXPECT_GT(rent.values[11], rent.values[0]);
+}
+
+TEST(BudgetSimulatorTest, ExceedanceAgainstBootstrappedMonths) {
+    TransactionData data;
+    char date[16];
+    for (int m = 0; m < 12; ++m) {
+        snprintf(date, sizeof(date), "2024-%02d-10", m + 1);
+        // Coffee is $100 in three months out of four and $300 otherwise
+        double coffee = m % 4 == 3 ? -300.0 : -100.0;
+        data.addTransaction(makeTransaction(date, "Food/Dining/Coffee", coffee));
+        data.addTransaction(makeTransaction(date, "Rent", -1000.0));
+    }
+    
+    AlertSystem alerts;
+    alerts.setOverallLimit(1200.0);
+    alerts.setCategoryLimit("Food", 200.0);
+    alerts.setCategoryLimit("Rent", 1000.0);
+    
+    SimulationResult result = BudgetSimulator(20000).run(DataCube(data), alerts);
+    ASSERT_EQ(result.outlooks.size(), 3u);
+    EXPECT_EQ(result.historyMonths, 12u);
+    
+    const LimitOutlook& overall = result.outlooks[0];
+    EXPECT_NEAR(overall.exceedanceProbability, 0.25, 0.02);
+    EXPECT_DOUBLE_EQ(overall.median, 1100.0);
+    EXPECT_DOUBLE_EQ(overall.p99, 1300.0);
+    
+    // "Food" covers Food/Dining/Coffee
+    const LimitOutlook& food = result.outlooks[1];
+    EXPECT_EQ(food.category, "Food");
+    EXPECT_NEAR(food.exceedanceProbability, 0.25, 0.02);
+    EXPECT_DOUBLE_EQ(result.outlooks[2].exceedanceProbability, 0.0);
+    
+    // Fixed per-block streams make runs reproducible
+    SimulationResult again = BudgetSimulator(20000).run(DataCube(data), alerts);
+    EXPECT_DOUBLE_EQ(again.outlooks[0].exceedanceProbability, overall.exceedanceProbability);
+}
+
+TEST(BudgetAnalyzerTest, ExcludesMatchedTransfers) {
+    TransactionData data;
+    data.addTransaction(makeTransaction("2024-01-05", "Transfers", -500.0, "Checking"));
+    data.addTransaction(makeTransaction("2024-01-07", "Transfers", 500.0, "Savings"));
+    // Same amount but outside the window: a real expense and a real deposit
+    data.addTransaction(makeTransaction("2024-02-01", "Rent", -500.0, "Checking"));
+    data.addTransaction(makeTransaction("2024-02-20", "Income", 500.0, "Savings"));
+    // Same account on both sides is not a transfer
+    data.addTransaction(makeTransaction("2024-03-01", "Refunds", -20.0, "Checking"));
+    data.addTransaction(makeTransaction("2024-03-01", "Refunds", 20.0, "Checking"));
+    
+    BudgetAnalyzer analyzer(data);
+    std::vector<TransferMatch> transfers = analyzer.getTransfers();
+    ASSERT_EQ(transfers.size(), 1u);
+    EXPECT_EQ(transfers[0].outflow, 0u);
+    EXPECT_EQ(transfers[0].inflow, 1u);
+    EXPECT_EQ(transfers[0].days, 2);
+    
+    BudgetSummary summary = analyzer.analyzeBudget();
+    EXPECT_DOUBLE_EQ(summary.totalIncome, 520.0);
+    EXPECT_DOUBLE_EQ(summary.totalExpenses, 520.0);
+    EXPECT_DOUBLE_EQ(summary.transferVolume, 500.0);
+    EXPECT_EQ(summary.categoryBreakdown.count("Transfers"), 0u);
+    
+    analyzer.setTransferMatchWindow(1);
+    EXPECT_DOUBLE_EQ(analyzer.analyzeBudget().totalIncome, 1020.0);
+}
+
+TEST(BudgetAnalyzerTest, MatchesForeignTransfersOnStatementAmounts) {
+    CurrencyConverter converter("USD");
+    converter.addRate("2024-01-05", "EUR", 1.10);
+    converter.addRate("2024-01-06", "EUR", 1.20);
+    converter.addRate("2024-01-05", "GBP", 1.20);
+    
+    std::vector<Transaction> rows = {
+        makeTransaction("2024-01-05", "Transfers", -100.0, "EUR Checking"),
+        makeTransaction("2024-01-06", "Transfers", 100.0, "EUR Savings"),
+        // Converts to $120.00 like the USD charge below, but is a different amount
+        makeTransaction("2024-01-05", "Income", 100.0, "GBP Current"),
+        makeTransaction("2024-01-05", "Rent", -120.0, "USD Checking"),
+    };
+    rows[0].currency = rows[1].currency = "eur";
+    rows[2].currency = "GBP";
+    converter.convert(rows);
+    ASSERT_NE(rows[0].amount, -rows[1].amount);
+    ASSERT_DOUBLE_EQ(rows[2].amount, -rows[3].amount);
+    
+    TransactionData data;
+    for (const auto& row : rows) data.addTransaction(row);
+    std::vector<TransferMatch> transfers = TransferMatcher(3).match(data);
+    ASSERT_EQ(transfers.size(), 1u);
+    EXPECT_EQ(transfers[0].outflow, 0u);
+    EXPECT_EQ(transfers[0].inflow, 1u);
+    EXPECT_EQ(transfers[0].days, 1);
+}
+
+TEST(BudgetAnalyzerTest, TimeSeriesAndSketchesAgreeWithCubeOnTransfers) {
+    TransactionData data;
+    for (int month = 1; month <= 3; ++month) {
+        std::string day = "2024-0" + std::to_string(month) + "-";
+        data.addTransaction(makeTransaction(day + "02", "Groceries", -80.0 - month, "Checking"));
+        data.addTransaction(makeTransaction(day + "10", "Transfers", -400.0, "Checking"));
+        data.addTransaction(makeTransaction(day + "11", "Transfers", 400.0, "Savings"));
+    }
+    
+    BudgetAnalyzer analyzer(data);
+    ASSERT_EQ(analyzer.getTransfers().size(), 3u);
+    auto series = analyzer.getTimeSeries(Granularity::Month);
+    ASSERT_EQ(series->periodCount(), 3u);
+    EXPECT_DOUBLE_EQ(series->rangeTotal(0, 2), analyzer.getDataCube()->total().spending);
+    EXPECT_DOUBLE_EQ(series->rangeTotal(0, 2), -246.0);
+    EXPECT_DOUBLE_EQ(series->periodTotal(0, "Transfers"), 0.0);
+    EXPECT_EQ(series->transactionCount(0), 1u);
+    
+    EXPECT_EQ(analyzer.getSizeDistributions().overall.count, 3u);
+    EXPECT_EQ(analyzer.getSizeDistributions().byCategory.count("Transfers"), 0u);
+    EXPECT_EQ(analyzer.getDistinctMerchants().byCategory.count("Transfers"), 0u);
+    for (const auto& recurring : analyzer.getRecurringPayments()) {
+        EXPECT_NE(recurring.category, "Transfers");
+    }
+    
+    analyzer.setTransferMatchWindow(-1);
+    EXPECT_DOUBLE_EQ(analyzer.getTimeSeries(Granularity::Month)->rangeTotal(0, 2),
+                     analyzer.getDataCube()->total().spending);
+    EXPECT_EQ(analyzer.getSizeDistributions().overall.count, 9u);
+    EXPECT_FALSE(analyzer.getRecurringPayments().empty());
+}
+
+static Transaction withBalance(Transaction t, double balance) {
+    t.balance = balance;
+    t.hasBalance = true;
+    return t;
+}
+
+TEST(ReconcilerTest, FlagsGapsDuplicatesAndMissingStatements) {
+    TransactionData data;
+    // Rows arrive out of order; the reconciler sorts them by date
+    data.addTransaction(withBalance(makeTransaction("2024-01-03", "Coffee", -5.0), 945.0));
+    data.addTransaction(withBalance(makeTransaction("2024-01-01", "Groceries", -50.0), 950.0));
+    data.addTransaction(withBalance(makeTransaction("2024-01-03", "Coffee", -5.0), 945.0));
+    // A $100 charge is missing from the import before this row
+    data.addTransaction(withBalance(makeTransaction("2024-01-10", "Income", 500.0), 1345.0));
+    data.addTransaction(withBalance(makeTransaction("2024-03-01", "Gas", -45.0), 1300.0));
+    
+    Reconciler reconciler;
+    std::vector<AccountReconciliation> accounts = reconciler.reconcile(data);
+    ASSERT_EQ(accounts.size(), 1u);
+    const AccountReconciliation& checking = accounts[0];
+    EXPECT_EQ(checking.transactions, 5u);
+    EXPECT_DOUBLE_EQ(checking.openingBalance, 1000.0);
+    EXPECT_DOUBLE_EQ(checking.closingBalance, 1300.0);
+    
+    ASSERT_EQ(checking.flags.size(), 3u);
+    EXPECT_EQ(checking.flags[0].issue, ReconciliationIssue::Duplicate);
+    EXPECT_EQ(checking.flags[1].issue, ReconciliationIssue::BalanceGap);
+    EXPECT_EQ(checking.flags[1].date, "2024-01-10");
+    EXPECT_DOUBLE_EQ(checking.flags[1].amount, -100.0);
+    EXPECT_EQ(checking.flags[2].issue, ReconciliationIssue::MissingStatement);
+    EXPECT_EQ(checking.flags[2].days, 51);
+    
+    RecurringSeries rent;
+    rent.merchant = "rent";
+    rent.accountName = "Checking";
+    rent.period = RecurrencePeriod::Monthly;
+    rent.nextExpectedDate = "2024-03-15";
+    rent.nextExpectedAmount = -1100.0;  // Converted; the projection stays in statement units
+    rent.nextStatementAmount = -1000.0;
+    rent.active = true;
+    std::vector<CashFlowProjection> projection =
+        reconciler.projectCashFlow(accounts, {rent}, 60);
+    ASSERT_EQ(projection[0].points.size(), 2u);
+    EXPECT_DOUBLE_EQ(projection[0].points[1].balance, -700.0);
+    EXPECT_EQ(projection[0].lowestDate, "2024-04-15");
+}
+
+TEST(AlertSystemTest, FlagsOutlierDuringIngest) {
+    AlertSystem alerts;
+    alerts.setAnomalyThreshold(5.0, 8);
+    alerts.setReportingCurrency("GBP");
+    int callbacks = 0;
+    alerts.setAlertCallback([&callbacks](const Alert&) { callbacks++; });
+    
+    double amounts[] = {42, 55, 38, 61, 47, 52, 44, 58, 49, 51};
+    for (double amount : amounts) {
+        EXPECT_FALSE(alerts.observeTransaction(makeTransaction("2024-01-05", "Groceries", -amount)));
+    }
+    EXPECT_TRUE(alerts.observeTransaction(makeTransaction("2024-01-20", "Groceries", -400.0)));
+    EXPECT_FALSE(alerts.observeTransaction(makeTransaction("2024-01-21", "Groceries", 400.0)));
+    
+    auto emitted = alerts.getIngestAlerts();
+    ASSERT_EQ(emitted.size(), 1u);
+    EXPECT_EQ(emitted[0].type, Alert::WARNING);
+    EXPECT_EQ(emitted[0].category, "Groceries");
+    EXPECT_DOUBLE_EQ(emitted[0].amount, 400.0);
+    EXPECT_NE(emitted[0].message.find("\xC2\xA3" "400.00"), std::string::npos);
+    EXPECT_EQ(emitted[0].message.find('$'), std::string::npos);
+    EXPECT_EQ(callbacks, 1);
+}
@@ -1,6 +1,723 @@
-// Placeholder test for ConfigManager to satisfy CMake test list
+// GoogleTest unit tests for ConfigManager, KeywordMatcher, RuleProgram, CategoryCache,
+// JsonReader, FuzzyMatcher and NaiveBayesClassifier
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include "ConfigManager.h"
+#include "FuzzyMatcher.h"
+#include "KeywordMatcher.h"
+#include "NaiveBayesClassifier.h"
+#include "TransactionData.h"
 
 TEST(ConfigManagerPlaceholder, Basic) {
     EXPECT_TRUE(true);
 }
+
+TEST(ConfigManagerTest, CacheSharesStoreNumbersAndCountsHits) {
+    ConfigManager config;
+    CategoryId first = config.categorize("STARBUCKS #1234");
+    CategoryId second = config.categorize("Starbucks #98765");
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(config.categoryName(first), "Dining");
+    EXPECT_EQ(config.categorize("ACME WIDGETS"), ConfigManager::kOther);
+    
+    CategoryCacheStats stats = config.getCacheStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.entries, 2u);
+    
+    // Reloading the rules invalidates the cache
+    config.loadDefaultCategories();
+    EXPECT_EQ(config.getCacheStats().entries, 0u);
+}
+
+TEST(ConfigManagerTest, BatchMatchesSingleRowCategorization) {
+    ConfigManager config;
+    const char* merchants[] = {"SHELL OIL 5521", "Netflix.com", "UBER TRIP", "ACME", "CVS/PHARMACY"};
+    std::vector<std::string> rows;
+    for (size_t i = 0; i < 3 * ConfigManager::kParallelBatch; ++i) {
+        rows.push_back(std::string(merchants[(i / 3) % 5]) + " #" + std::to_string(i % 97));
+    }
+    std::vector<std::string_view> views(rows.begin(), rows.end());
+    
+    std::vector<CategoryId> ids = config.categorizeBatch(views);
+    ASSERT_EQ(ids.size(), rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        ASSERT_EQ(config.categoryName(ids[i]), config.categorizeTransaction(rows[i])) << rows[i];
+    }
+}
+
+TEST(ConfigManagerTest, RecategorizeAppliesReloadedRules) {
+    TransactionData data;
+    Transaction t;
+    t.date = "2024-01-05";
+    t.amount = -4.5;
+    t.description = "BLUE BOTTLE 0042";
+    t.category = "Other";
+    data.addTransaction(t);
+    t.description = "SAFEWAY 17";
+    t.category = "Groceries";
+    data.addTransaction(t);
+    uint64_t version = data.getVersion();
+    
+    ConfigManager config;
+    EXPECT_EQ(data.recategorize(config), 0u);
+    EXPECT_EQ(data.getVersion(), version);
+    
+    std::string path = ::testing::TempDir() + "recategorize_rules.json";
+    {
+        std::ofstream out(path);
+        out << "{\n  \"categories\": [\n    {\n      \"category\": \"Food/Dining/Coffee\",\n"
+            << "      \"keywords\": [\n        \"blue bottle\"\n      ]\n    }\n  ]\n}\n";
+    }
+    ASSERT_TRUE(config.loadCategoriesFromFile(path));
+    EXPECT_EQ(data.recategorize(config), 2u);
+    EXPECT_EQ(data.getAllTransactions()[0].category, "Food/Dining/Coffee");
+    EXPECT_EQ(data.getAllTransactions()[1].category, "Other");
+    EXPECT_GT(data.getVersion(), version);
+    std::remove(path.c_str());
+}
+
+TEST(ConfigManagerTest, IncrementalRecategorizeMatchesFullPass) {
+    const char* merchants[] = {"BLUE BOTTLE #12", "Safeway 0017", "Joe's Cafe 3", "SHELL OIL",
+                               "Uber *Trip", "GOODWILL STORE", "Netflix.com", "ACME 7"};
+    TransactionData incremental, full;
+    for (int i = 0; i < 64; ++i) {
+        Transaction t;
+        t.date = "2024-02-" + std::to_string(10 + i % 18);
+        t.amount = -1.0 - i;
+        t.description = merchants[i % 8];
+        t.category = "Other";
+        incremental.addTransaction(t);
+        full.addTransaction(t);
+    }
+    
+    std::string path = ::testing::TempDir() + "incremental_rules.json";
+    auto load = [&](ConfigManager& config, const char* json) {
+        std::ofstream(path) << json;
+        std::remove((path + ConfigManager::kRuleCacheSuffix).c_str());
+        ASSERT_TRUE(config.loadCategoriesFromFile(path));
+    };
+    ConfigManager config;
+    load(config, R"({"categories":[{"category":"Coffee","keywords":["bottle"]},
+        {"category":"Groceries","keywords":["safeway"]},
+        {"category":"Gas","keywords":["shell"]}]})");
+    incremental.recategorize(config);
+    full.recategorize(config);
+    
+    // Keywords change in one rule, another is replaced and an override is added
+    CategoryConfig previous = config.getConfig();
+    load(config, R"({"categories":[{"category":"Coffee","keywords":["bottle","cafe"]},
+        {"category":"Rides","keywords":["uber"]},
+        {"category":"Gas","keywords":["shell"]}],
+        "overrides":{"Goodwill Store":"Charity"}})");
+    std::vector<std::string> keywords;
+    ASSERT_TRUE(ConfigManager::changedKeywords(previous, config.getConfig(), keywords));
+    EXPECT_EQ(keywords, (std::vector<std::string>{"cafe", "goodwill store", "safeway", "uber"}));
+    
+    size_t changed = incremental.recategorize(config, previous);
+    EXPECT_EQ(changed, full.recategorize(config));
+    EXPECT_EQ(changed, 32u);
+    for (size_t i = 0; i < 64; ++i) {
+        ASSERT_EQ(incremental.getAllTransactions()[i].category,
+                  full.getAllTransactions()[i].category) << i;
+    }
+    EXPECT_EQ(incremental.getAllTransactions()[5].category, "Charity");
+    
+    std::vector<CategoryChange> changes;
+    EXPECT_TRUE(incremental.getCategoryChanges(incremental.getVersion() - 1, changes));
+    EXPECT_EQ(changes.size(), changed);
+    EXPECT_FALSE(incremental.getCategoryChanges(incremental.getVersion() - 2, changes));
+    
+    // A rule without keywords cannot be bounded, so every row is re-evaluated
+    previous = config.getConfig();
+    load(config, R"({"categories":[{"category":"Any","pattern":"."}]})");
+    EXPECT_FALSE(ConfigManager::changedKeywords(previous, config.getConfig(), keywords));
+    EXPECT_EQ(incremental.recategorize(config, previous), 64u);
+    std::remove(path.c_str());
+    std::remove((path + ConfigManager::kRuleCacheSuffix).c_str());
+}
+
+TEST(JsonReaderTest, ParsesMinifiedCategoriesWithEscapes) {
+    auto rules = ConfigManager::parseCategories(
+        "{\"version\":2,\"categories\":[{\"category\":\"Food\\/Dining\",\"extra\":[1,{\"a\":null}],"
+        "\"keywords\":[\"caf\\u00e9\",\"say \\\"hi\\\"\"]},{\"category\":\"Empty\",\"keywords\":[]}]}")
+        .rules;
+    ASSERT_EQ(rules.size(), 1u);
+    EXPECT_EQ(rules[0].category, "Food/Dining");
+    ASSERT_EQ(rules[0].keywords.size(), 2u);
+    EXPECT_EQ(rules[0].keywords[0], "caf\xc3\xa9");
+    EXPECT_EQ(rules[0].keywords[1], "say \"hi\"");
+    
+    EXPECT_THROW(ConfigManager::parseCategories("{\"categories\":[}"), std::runtime_error);
+    EXPECT_THROW(ConfigManager::parseCategories("{\"categories\":[],}"), std::runtime_error);
+    EXPECT_THROW(ConfigManager::parseCategories("{} {}"), std::runtime_error);
+}
+
+TEST(ConfigManagerTest, CompiledRuleCacheIsReusedAndRefreshed) {
+    std::string path = ::testing::TempDir() + "cached_rules.json";
+    std::string cachePath = path + ConfigManager::kRuleCacheSuffix;
+    std::remove(cachePath.c_str());
+    auto write = [&](const std::string& keyword) {
+        std::ofstream out(path);
+        out << "{\"categories\":[{\"category\":\"Pets\",\"keywords\":[\"" << keyword << "\"]}]}";
+    };
+    
+    write("petco");
+    ConfigManager first;
+    ASSERT_TRUE(first.loadCategoriesFromFile(path));
+    EXPECT_FALSE(first.loadedFromRuleCache());
+    
+    ConfigManager second;
+    ASSERT_TRUE(second.loadCategoriesFromFile(path));
+    EXPECT_TRUE(second.loadedFromRuleCache());
+    EXPECT_EQ(second.categorizeTransaction("PETCO #12"), "Pets");
+    EXPECT_EQ(second.categorizeTransaction("SAFEWAY"), "Other");
+    ASSERT_EQ(second.getCategories().size(), 1u);
+    EXPECT_EQ(second.getCategories()[0].keywords[0], "petco");
+    
+    // Editing the JSON changes its hash and forces a recompile
+    write("petsmart");
+    ConfigManager third;
+    ASSERT_TRUE(third.loadCategoriesFromFile(path));
+    EXPECT_FALSE(third.loadedFromRuleCache());
+    EXPECT_EQ(third.categorizeTransaction("PETCO #12"), "Other");
+    EXPECT_EQ(third.categorizeTransaction("PetSmart"), "Pets");
+    
+    std::remove(path.c_str());
+    std::remove(cachePath.c_str());
+}
+
+TEST(CategoryCacheTest, StaysWithinCapacityUnderConcurrentUse) {
+    CategoryCache cache(64);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t] {
+            for (int i = 0; i < 1000; ++i) {
+                std::string key = "merchant " + std::to_string((i * 7 + t) % 300);
+                CategoryId id;
+                if (!cache.lookup(key, id)) cache.insert(key, static_cast<CategoryId>(i % 5));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    
+    CategoryCacheStats stats = cache.stats();
+    EXPECT_EQ(stats.hits + stats.misses, 4000u);
+    EXPECT_LE(stats.entries, cache.getCapacity());
+}
+
+TEST(ConfigManagerTest, DefaultRulesKeepFirstRuleWins) {
+    ConfigManager config;
+    EXPECT_EQ(config.categorizeTransaction("SAFEWAY #1234"), "Groceries");
+    // "gas" (Gas) is listed before "gas bill" (Utilities)
+    EXPECT_EQ(config.categorizeTransaction("PG&E GAS BILL"), "Gas");
+    EXPECT_EQ(config.categorizeTransaction("Starbucks Coffee"), "Dining");
+    EXPECT_EQ(config.categorizeTransaction("ACME WIDGETS"), "Other");
+    EXPECT_EQ(config.categorizeTransaction(""), "Other");
+}
+
+// Reference semantics: rules in order, keywords in order, case-insensitive substring search
+static uint32_t naiveMatch(const std::vector<std::vector<std::string>>& rules,
+                           std::string text) {
+    auto lower = [](std::string s) {
+        std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+        return s;
+    };
+    text = lower(text);
+    for (uint32_t r = 0; r < rules.size(); ++r) {
+        for (const auto& keyword : rules[r]) {
+            if (text.find(lower(keyword)) != std::string::npos) return r;
+        }
+    }
+    return KeywordMatcher::npos;
+}
+
+TEST(KeywordMatcherTest, AgreesWithSubstringSearch) {
+    std::mt19937 rng(42);
+    const std::string alphabet = "abAB c";
+    auto randomString = [&](size_t maxLength) {
+        std::string s(rng() % (maxLength + 1), ' ');
+        for (auto& c : s) c = alphabet[rng() % alphabet.size()];
+        return s;
+    };
+    
+    for (int trial = 0; trial < 50; ++trial) {
+        std::vector<std::vector<std::string>> rules(1 + rng() % 6);
+        for (auto& rule : rules) {
+            for (size_t k = rng() % 4; k > 0; --k) rule.push_back(randomString(4));
+        }
+        KeywordMatcher matcher;
+        matcher.compile(rules);
+        for (int probe = 0; probe < 200; ++probe) {
+            std::string text = randomString(12);
+            ASSERT_EQ(matcher.match(text), naiveMatch(rules, text)) << "text: " << text;
+        }
+    }
+}
+
+TEST(KeywordMatcherTest, OverlappingKeywordsAndEmptyKeyword) {
+    KeywordMatcher matcher;
+    matcher.compile({{"shell"}, {"she", "hell"}, {""}});
+    EXPECT_EQ(matcher.match("SHELL OIL"), 0u);
+    EXPECT_EQ(matcher.match("ushers"), 1u);  // "she" via a failure link
+    EXPECT_EQ(matcher.match("hello"), 1u);
+    EXPECT_EQ(matcher.match("xyz"), 2u);     // The empty keyword matches everything
+}
+
+TEST(ConfigManagerTest, ConditionalRulesAndMerchantOverrides) {
+    std::string path = ::testing::TempDir() + "conditional_rules.json";
+    std::string cachePath = path + ConfigManager::kRuleCacheSuffix;
+    std::remove(cachePath.c_str());
+    {
+        std::ofstream out(path);
+        out << R"({"categories":[
+            {"category":"Shopping","pattern":"^AMZN Mktp","maxAmount":-0.01,"account":"Checking"},
+            {"category":"Refunds","pattern":"^AMZN","minAmount":0.01},
+            {"category":"Travel","keywords":["hotel"],"startDate":"2024-06-01","endDate":"2024-06-30"},
+            {"category":"Lodging","keywords":["hotel"]}],
+            "overrides":{"Joe's Hotel #42":"Food/Dining"}})";
+    }
+    
+    for (int pass = 0; pass < 2; ++pass) {
+        ConfigManager config;
+        ASSERT_TRUE(config.loadCategoriesFromFile(path));
+        EXPECT_EQ(config.loadedFromRuleCache(), pass == 1);
+        
+        auto name = [&](const char* description, double amount, const char* account,
+                        const char* date) {
+            CategorizationInput input;
+            input.description = description;
+            input.amount = amount;
+            input.account = account;
+            input.date = date;
+            return config.categoryName(config.categorize(input));
+        };
+        EXPECT_EQ(name("AMZN Mktp US*2K4", -25.0, "Checking", "2024-03-02"), "Shopping");
+        EXPECT_EQ(name("amzn mktp us*2k4", -25.0, "Savings", "2024-03-02"), "Other");
+        EXPECT_EQ(name("AMZN Mktp US*2K4", 25.0, "Checking", "2024-03-02"), "Refunds");
+        EXPECT_EQ(name("MARRIOTT HOTEL", -300.0, "Checking", "2024-06-15"), "Travel");
+        EXPECT_EQ(name("MARRIOTT HOTEL", -300.0, "Checking", "2024-07-01"), "Lodging");
+        EXPECT_EQ(name("JOES HOTEL 7", -12.0, "Checking", "2024-06-15"), "Travel");
+        EXPECT_EQ(name("Joe's Hotel #17", -12.0, "Checking", "2024-06-15"), "Food/Dining");
+        // Without an amount the amount-conditioned rules cannot match
+        EXPECT_EQ(config.categorizeTransaction("AMZN Mktp US"), "Other");
+    }
+    std::remove(path.c_str());
+    std::remove(cachePath.c_str());
+}
+
+namespace {
+
+uint32_t naiveEvaluate(const std::vector<CategoryRule>& rules, const CategorizationInput& input) {
+    auto lower = [](std::string s) {
+        std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+        return s;
+    };
+    std::string text = lower(std::string(input.description));
+    for (uint32_t r = 0; r < rules.size(); ++r) {
+        const CategoryRule& rule = rules[r];
+        bool keyword = rule.keywords.empty() ||
+            std::any_of(rule.keywords.begin(), rule.keywords.end(), [&](const std::string& k) {
+                return text.find(lower(k)) != std::string::npos;
+            });
+        bool amount = !rule.hasAmountRange() ||
+            (!std::isnan(input.amount) && input.amount >= rule.minAmount - 1e-9 &&
+             input.amount <= rule.maxAmount + 1e-9);
+        bool account = rule.account.empty() || rule.account == input.account;
+        bool dated = !input.date.empty();
+        bool date = (rule.startDate.empty() || (dated && input.date >= rule.startDate)) &&
+                    (rule.endDate.empty() || (dated && input.date <= rule.endDate));
+        if (keyword && amount && account && date) return r;
+    }
+    return RuleProgram::npos;
+}
+
+} // namespace
+
+TEST(RuleProgramTest, AgreesWithRuleByRuleEvaluation) {
+    std::mt19937 rng(7);
+    const std::string alphabet = "abc ";
+    const char* accounts[] = {"A", "B", ""};
+    const char* dates[] = {"2024-01-10", "2024-02-10", "2024-03-10", ""};
+    auto randomString = [&](size_t maxLength) {
+        std::string s(1 + rng() % maxLength, ' ');
+        for (auto& c : s) c = alphabet[rng() % alphabet.size()];
+        return s;
+    };
+    
+    for (int trial = 0; trial < 30; ++trial) {
+        std::vector<CategoryRule> rules(1 + rng() % 90);
+        for (auto& rule : rules) {
+            rule.category = "C";
+            for (size_t k = rng() % 3; k > 0; --k) rule.keywords.push_back(randomString(3));
+            if (rng() % 3 == 0) rule.minAmount = double(int(rng() % 200) - 100);
+            if (rng() % 3 == 0) rule.maxAmount = double(int(rng() % 200) - 100);
+            if (rng() % 4 == 0) rule.account = accounts[rng() % 2];
+            if (rng() % 4 == 0) rule.startDate = dates[rng() % 3];
+            if (rng() % 4 == 0) rule.endDate = dates[rng() % 3];
+        }
+        RuleProgram program;
+        program.compile(rules);
+        for (int probe = 0; probe < 200; ++probe) {
+            std::string text = randomString(10);
+            CategorizationInput input;
+            input.description = text;
+            input.amount = (rng() % 5 == 0) ? std::nan("") : double(int(rng() % 240) - 120);
+            input.account = accounts[rng() % 3];
+            input.date = dates[rng() % 4];
+            ASSERT_EQ(program.evaluate(input), naiveEvaluate(rules, input)) << "text: " << text;
+        }
+    }
+}
+
+TEST(ConfigManagerTest, ReloadsNeverTearUnderConcurrentReaders) {
+    std::string path = ::testing::TempDir() + "swapped_rules.json";
+    auto write = [&](const char* category) {
+        std::ofstream out(path);
+        out << "{\"categories\":[{\"category\":\"" << category
+            << "\",\"keywords\":[\"alpha\"]},{\"category\":\"" << category
+            << "\",\"pattern\":\"^beta\"}]}";
+    };
+    write("One");
+    ConfigManager config;
+    ASSERT_TRUE(config.loadCategoriesFromFile(path));
+    
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                // Both rows must come from the same rule set
+                std::vector<CategoryId> ids = config.categorizeBatch(
+                    std::vector<std::string_view>{"ALPHA 1", "beta 2"});
+                std::string first = config.categoryName(ids[0]);
+                if (first != config.categoryName(ids[1]) || first == "Other") torn++;
+            }
+        });
+    }
+    for (int i = 0; i < 20; ++i) {
+        write(i % 2 ? "One" : "Two");
+        ASSERT_TRUE(config.loadCategoriesFromFile(path));
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_GE(config.getRulesVersion(), 21u);
+    
+    std::remove(path.c_str());
+    std::remove((path + ConfigManager::kRuleCacheSuffix).c_str());
+}
+
+TEST(ConfigManagerTest, WatchedFileIsReloadedInBackground) {
+    std::string path = ::testing::TempDir() + "watched_rules.json";
+    auto write = [&](const char* keyword) {
+        std::ofstream out(path);
+        out << "{\"categories\":[{\"category\":\"Pets\",\"keywords\":[\"" << keyword
+            << "\"]}]}";
+    };
+    write("petco");
+    
+    ConfigManager config;
+    ASSERT_TRUE(config.loadCategoriesFromFile(path));
+    std::mutex mutex;
+    std::condition_variable reloaded;
+    int reloads = 0;
+    config.setReloadCallback([&](bool loaded, const std::string&, const CategoryConfig&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (loaded) reloads++;
+        reloaded.notify_all();
+    });
+    ASSERT_TRUE(config.watchCategoriesFile(path));
+    
+    write("petsmart");
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(reloaded.wait_for(lock, std::chrono::seconds(5), [&] { return reloads > 0; }));
+    }
+    EXPECT_EQ(config.categorizeTransaction("PETSMART 12"), "Pets");
+    EXPECT_EQ(config.categorizeTransaction("PETCO 12"), "Other");
+    config.stopWatching();
+    
+    std::remove(path.c_str());
+    std::remove((path + ConfigManager::kRuleCacheSuffix).c_str());
+}
+
+TEST(ConfigManagerTest, WatchedReloadRecategorizesIncrementally) {
+    std::string path = ::testing::TempDir() + "watched_incremental_rules.json";
+    auto write = [&](const char* json) {
+        std::ofstream(path) << json;
+        std::remove((path + ConfigManager::kRuleCacheSuffix).c_str());
+    };
+    write(R"({"categories":[{"category":"Coffee","keywords":["bottle"]},
+        {"category":"Gas","keywords":["shell"]}]})");
+    
+    const char* merchants[] = {"BLUE BOTTLE #12", "Joe's Cafe 3", "SHELL OIL", "Uber *Trip"};
+    TransactionData incremental, full;
+    for (int i = 0; i < 16; ++i) {
+        Transaction t;
+        t.date = "2024-03-" + std::to_string(10 + i);
+        t.amount = -1.0 - i;
+        t.description = merchants[i % 4];
+        t.category = "Other";
+        incremental.addTransaction(t);
+        full.addTransaction(t);
+    }
+    ConfigManager config;
+    ASSERT_TRUE(config.loadCategoriesFromFile(path));
+    incremental.recategorize(config);
+    
+    std::mutex mutex;
+    std::condition_variable reloaded;
+    std::unique_ptr<CategoryConfig> previous;
+    config.setReloadCallback([&](bool loaded, const std::string&, const CategoryConfig& rules) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (loaded) previous = std::make_unique<CategoryConfig>(rules);
+        reloaded.notify_all();
+    });
+    ASSERT_TRUE(config.watchCategoriesFile(path));
+    
+    write(R"({"categories":[{"category":"Coffee","keywords":["bottle","cafe"]},
+        {"category":"Rides","keywords":["uber"]}]})");
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(reloaded.wait_for(lock, std::chrono::seconds(5),
+                                      [&] { return previous != nullptr; }));
+    }
+    config.stopWatching();
+    
+    // The rules handed to the callback are the ones the data was categorized under
+    size_t changed = incremental.recategorize(config, *previous);
+    full.recategorize(config);
+    EXPECT_EQ(changed, 12u);
+    for (size_t i = 0; i < 16; ++i) {
+        ASSERT_EQ(incremental.getAllTransactions()[i].category,
+                  full.getAllTransactions()[i].category) << i;
+    }
+    EXPECT_EQ(incremental.getAllTransactions()[1].category, "Coffee");
+    EXPECT_EQ(incremental.getAllTransactions()[2].category, "Other");
+    
+    std::remove(path.c_str());
+    std::remove((path + ConfigManager::kRuleCacheSuffix).c_str());
+}
+
+TEST(FuzzyMatcherTest, AgreesWithExhaustiveTrigramSearch) {
+    auto grams = [](const std::string& merchant) {
+        std::string padded = "  " + merchant + " ";
+        std::set<std::string> result;
+        for (size_t i = 0; i + 3 <= padded.size(); ++i) result.insert(padded.substr(i, 3));
+        return result;
+    };
+    
+    std::mt19937 rng(7);
+    auto word = [&]() {
+        std::string w;
+        size_t length = 3 + rng() % 6;
+        for (size_t i = 0; i < length; ++i) w += static_cast<char>('a' + rng() % 8);
+        return w;
+    };
+    FuzzyMatcher matcher(0.45);
+    std::vector<std::string> names;
+    for (int i = 0; i < 3000; ++i) {
+        std::string name = word() + (rng() % 2 ? " " + word() : "");
+        matcher.add(name, "C" + std::to_string(i % 40));
+        names.push_back(name);
+    }
+    matcher.build();
+    
+    // Unique names keep their first category, in insertion order
+    std::vector<std::pair<std::string, std::string>> dictionary;
+    std::set<std::string> seen;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (seen.insert(names[i]).second) {
+            dictionary.emplace_back(names[i], "C" + std::to_string(i % 40));
+        }
+    }
+    
+    for (int q = 0; q < 300; ++q) {
+        std::string query = names[rng() % names.size()];
+        query[rng() % query.size()] = static_cast<char>('a' + rng() % 8);
+        if (rng() % 2) query += static_cast<char>('a' + rng() % 8);
+        if (query.front() == ' ' || query.back() == ' ' || query.find("  ") != std::string::npos) {
+            continue;
+        }
+        
+        std::set<std::string> q3 = grams(query);
+        double bestScore = 0.0;
+        std::string expected;
+        for (const auto& entry : dictionary) {
+            if (entry.first == query) {
+                expected = entry.second;
+                bestScore = 2.0;
+                break;
+            }
+            std::set<std::string> c3 = grams(entry.first);
+            size_t overlap = 0;
+            for (const auto& g : q3) overlap += c3.count(g);
+            double score = static_cast<double>(overlap) / (q3.size() + c3.size() - overlap);
+            if (score > bestScore) {
+                bestScore = score;
+                expected = entry.second;
+            }
+        }
+        if (bestScore < 0.45) expected.clear();
+        ASSERT_EQ(matcher.match(query), expected) << query;
+    }
+}
+
+TEST(FuzzyMatcherTest, FillsUncategorizedRowsFromHistoryAndDictionary) {
+    std::string path = ::testing::TempDir() + "merchant_dictionary.csv";
+    {
+        std::ofstream out(path);
+        out << "merchant,category\n# Local favourites\nBlue Bottle Coffee,Food/Dining/Coffee\n"
+            << "Acme Hardware, Inc.,Home\n";
+    }
+    FuzzyMatcher matcher;
+    EXPECT_EQ(matcher.loadDictionary(path), 2u);
+    
+    TransactionData data;
+    Transaction t;
+    t.date = "2024-04-02";
+    t.amount = -20.0;
+    const char* rows[][2] = {{"SAFEWAY STORE 0017", "Food/Groceries"},
+                             {"SAFEWAY STORE 0022", "Food/Groceries"},
+                             {"SAFEWAY STORES #8", "Other"},
+                             {"SQ *BLUE BOTTLE COFFE 0423 OAKLAND CA", "Other"},
+                             {"ACME HARDWARE INC", "Other"},
+                             {"ZZYZX QUARRY", "Other"}};
+    for (const auto& row : rows) {
+        t.description = row[0];
+        t.category = row[1];
+        t.amount -= 1.0;
+        data.addTransaction(t);
+    }
+    matcher.addHistory(data);
+    matcher.build();
+    EXPECT_EQ(matcher.size(), 3u);
+    
+    EXPECT_EQ(data.fillUncategorized(matcher), 3u);
+    const auto& stored = data.getAllTransactions();
+    EXPECT_EQ(stored[2].category, "Food/Groceries");
+    EXPECT_EQ(stored[3].category, "Food/Dining/Coffee");
+    EXPECT_EQ(stored[4].category, "Home");
+    EXPECT_EQ(stored[5].category, "Other");
+    
+    // Misses are memoized too
+    EXPECT_EQ(matcher.match("zzyzx quarry"), "");
+    EXPECT_GE(matcher.getCacheStats().hits, 1u);
+    
+    std::ofstream(path) << "no comma here\n";
+    EXPECT_THROW(matcher.loadDictionary(path), std::runtime_error);
+    EXPECT_THROW(FuzzyMatcher(0.0), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+TEST(NaiveBayesClassifierTest, LearnsFromHistoryAndRoundTripsThroughFile) {
+    const char* history[][2] = {{"SHELL OIL 5521 HOUSTON TX", "Gas"},
+                                {"CHEVRON STATION 0042", "Gas"},
+                                {"SHELL SERVICE STATION", "Gas"},
+                                {"SAFEWAY STORE 17", "Groceries"},
+                                {"TRADER JOES MARKET #8", "Groceries"},
+                                {"WHOLE FOODS MARKET", "Groceries"},
+                                {"ACME 123", "Other"}};
+    TransactionData data;
+    for (int copy = 0; copy < 20; ++copy) {
+        for (const auto& row : history) {
+            Transaction t;
+            t.date = "2024-05-" + std::to_string(10 + copy);
+            t.amount = -10.0 - copy;
+            t.description = row[0];
+            t.category = row[1];
+            data.addTransaction(t);
+        }
+    }
+    
+    NaiveBayesClassifier model(12);
+    EXPECT_FALSE(model.isTrained());
+    EXPECT_EQ(model.classify("SHELL"), "");
+    EXPECT_EQ(model.train(data), 120u);
+    ASSERT_EQ(model.getCategories().size(), 2u);
+    
+    // Unseen descriptions sharing tokens with the history; digits never matter
+    EXPECT_EQ(model.classify("SHELL OIL 9999 DALLAS TX"), "Gas");
+    EXPECT_EQ(model.classify("GREENS MARKET"), "Groceries");
+    EXPECT_EQ(model.classify("ZZYZX QUARRY"), "");
+    
+    std::string path = ::testing::TempDir() + "category_model.bin";
+    model.save(path);
+    NaiveBayesClassifier loaded(12);
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.getCategories(), model.getCategories());
+    
+    std::vector<std::string> rows = {"CHEVRON 77", "whole foods", "station market", "", "tx"};
+    std::vector<std::string_view> views(rows.begin(), rows.end());
+    std::vector<uint32_t> a(rows.size()), b(rows.size());
+    std::vector<float> pa(rows.size()), pb(rows.size());
+    model.classifyBatch(views.data(), views.size(), a.data(), pa.data());
+    loaded.classifyBatch(views.data(), views.size(), b.data(), pb.data());
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(pa, pb);
+    
+    // Only rows still in "Other" are filled, and only when the model is confident
+    EXPECT_EQ(data.fillUncategorized(loaded), 0u);
+    Transaction t;
+    t.description = "SHELL OIL 77";
+    t.category = "Other";
+    data.addTransaction(t);
+    EXPECT_EQ(data.fillUncategorized(loaded), 1u);
+    EXPECT_EQ(data.getAllTransactions().back().category, "Gas");
+    
+    // A model of another width or a damaged file is refused
+    EXPECT_FALSE(NaiveBayesClassifier(13).load(path));
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(40);
+        file.put('\x7f');
+    }
+    EXPECT_FALSE(loaded.load(path));
+    EXPECT_EQ(loaded.classify("SHELL OIL"), "Gas");
+    std::remove(path.c_str());
+}
+
+TEST(NaiveBayesClassifierTest, DeclinesToTrainOnASingleCategory) {
+    TransactionData data;
+    for (int day = 10; day < 20; ++day) {
+        Transaction t;
+        t.date = "2024-05-" + std::to_string(day);
+        t.amount = -20.0;
+        t.description = "SHELL OIL 5521";
+        t.category = "Gas";
+        data.addTransaction(t);
+    }
+    Transaction other;
+    other.date = "2024-05-20";
+    other.description = "ACME 123";
+    other.category = "Other";
+    data.addTransaction(other);
+    
+    NaiveBayesClassifier model(12);
+    model.setConfidence(0.5);
+    EXPECT_EQ(model.train(data), 0u);
+    EXPECT_FALSE(model.isTrained());
+    EXPECT_EQ(model.classify("SHELL OIL"), "");
+    EXPECT_EQ(data.fillUncategorized(model), 0u);
+    EXPECT_EQ(data.getAllTransactions().back().category, "Other");
+    
+    // Nor does it load one
+    std::string path = ::testing::TempDir() + "single_category_model.bin";
+    model.save(path);
+    EXPECT_FALSE(model.load(path));
+    std::remove(path.c_str());
+}
@@ -1,11 +1,134 @@
 // Placeholder test for CSVParser to satisfy CMake test list
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "CSVParser.h"
+#include "CurrencyConverter.h"
+#include "DateParser.h"
+#include "MerchantNormalizer.h"
+#include "TransactionData.h"
 
 TEST(CSVParserPlaceholder, Basic) {
     EXPECT_TRUE(true);
 }
 
+TEST(CSVParserTest, StripsPoundAndEuroSymbols) {
+    std::string path = testing::TempDir() + "gbp_statement.csv";
+    {
+        std::ofstream out(path);
+        out << "Date,Description,Amount,Balance\n"
+            << "01/05/2024,PAYROLL,\"\xC2\xA3" "1,234.50\",\"\xC2\xA3" "2,000.00\"\n"
+            << "01/06/2024,CAFE,\xE2\x82\xAC" "-4.50,\n";
+    }
+    
+    CSVParser parser;
+    std::vector<Transaction> rows = parser.parseGeneric(path, "UK Current");
+    std::remove(path.c_str());
+    
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_DOUBLE_EQ(rows[0].amount, 1234.5);
+    EXPECT_DOUBLE_EQ(rows[0].balance, 2000.0);
+    EXPECT_TRUE(rows[0].hasBalance);
+    EXPECT_DOUBLE_EQ(rows[1].amount, -4.5);
+    EXPECT_FALSE(rows[1].hasBalance);
+}
+
+TEST(CurrencyConverterTest, CarriesRatesForwardAndConvertsInBatch) {
+    CurrencyConverter converter("usd");
+    converter.addRate("2024-01-05", "EUR", 1.10);  // Friday
+    converter.addRate("2024-01-08", "EUR", 1.20);  // Monday
+    
+    EXPECT_DOUBLE_EQ(converter.getRate("EUR", DateParser::toDayNumber("2024-01-06")), 1.10);
+    EXPECT_DOUBLE_EQ(converter.getRate("EUR", DateParser::toDayNumber("2024-01-01")), 1.10);
+    EXPECT_DOUBLE_EQ(converter.getRate("EUR", DateParser::toDayNumber("2024-02-01")), 1.20);
+    EXPECT_DOUBLE_EQ(converter.getRate("USD", 0), 1.0);
+    EXPECT_FALSE(converter.hasRates("GBP"));
+    
+    std::vector<Transaction> rows(3);
+    rows[0].date = "2024-01-07";
+    rows[0].amount = -10.0;
+    rows[0].currency = "EUR";
+    rows[1].date = "2024-01-08";
+    rows[1].amount = 100.0;
+    rows[1].currency = "eur";
+    rows[2].date = "2024-01-08";
+    rows[2].amount = 5.0;  // Already in the reporting currency
+    converter.convert(rows);
+    
+    EXPECT_DOUBLE_EQ(rows[0].amount, -11.0);
+    EXPECT_DOUBLE_EQ(rows[0].statementAmount(), -10.0);
+    EXPECT_DOUBLE_EQ(rows[1].amount, 120.0);
+    EXPECT_DOUBLE_EQ(rows[1].fxRate, 1.20);
+    EXPECT_DOUBLE_EQ(rows[2].amount, 5.0);
+    EXPECT_DOUBLE_EQ(rows[2].fxRate, 1.0);
+    
+    rows[2].currency = "GBP";
+    EXPECT_THROW(converter.convert(rows), std::runtime_error);
+}
+
+TEST(CurrencyConverterTest, ReportsTheLineOfABadRateDate) {
+    std::string path = testing::TempDir() + "bad_rates.csv";
+    {
+        std::ofstream out(path);
+        out << "date,currency,rate\n"
+            << "2024-01-05,EUR,1.10\n"
+            << "someday,EUR,1.20\n";
+    }
+    
+    CurrencyConverter converter;
+    try {
+        converter.loadRates(path);
+        ADD_FAILURE() << "expected std::runtime_error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("line 3"), std::string::npos) << e.what();
+    }
+    std::remove(path.c_str());
+}
+
 int csv_main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
+
+TEST(MerchantNormalizerTest, StripsProcessorsCodesAndLocations) {
+    EXPECT_EQ(normalizeMerchant("SQ *BLUE BOTTLE 0423 SAN FRANCISCO CA"), "blue bottle");
+    EXPECT_EQ(normalizeMerchant("TST* Blue Bottle"), "blue bottle");
+    EXPECT_EQ(normalizeMerchant("AMZN MKTP US*2K4L19"), "amzn mktp");
+    EXPECT_EQ(normalizeMerchant("POS DEBIT STARBUCKS #1234 XXXX5678"), "starbucks");
+    EXPECT_EQ(normalizeMerchant("SHELL OIL 5521 TX"), "shell oil");
+    EXPECT_EQ(normalizeMerchant("BLUE BOTTLE   OAKLAND CA"), "blue bottle");
+    EXPECT_EQ(normalizeMerchant("7-ELEVEN 01/15"), "eleven");
+    EXPECT_EQ(normalizeMerchant("7ELEVEN"), "eleven");
+    EXPECT_EQ(normalizeMerchant("Joe's Hotel #42"), "joe's hotel");
+    EXPECT_EQ(normalizeMerchant("NETFLIX.COM 866-579-7172"), "netflix com");
+    EXPECT_EQ(normalizeMerchant("UBER *TRIP"), "uber trip");
+    // Two words are not enough to tell a city from a name
+    EXPECT_EQ(normalizeMerchant("TACO CO"), "taco co");
+    EXPECT_EQ(normalizeMerchant("1234"), "");
+    
+    // Digit values never matter, only where the runs fall
+    EXPECT_EQ(normalizeMerchant("STARBUCKS #1"), normalizeMerchant("starbucks #99887"));
+    
+    const std::string& key = internMerchant("blue bottle");
+    EXPECT_EQ(&key, &internMerchant(normalizeMerchant("SQ *BLUE BOTTLE 0423")));
+}
+
+TEST(MerchantNormalizerTest, IngestStoresKeyAndDedupsAcrossRenderings) {
+    Transaction t;
+    t.date = "2024-03-02";
+    t.amount = -6.5;
+    t.accountName = "Checking";
+    t.description = "SQ *BLUE BOTTLE 0423 SAN FRANCISCO CA";
+    
+    TransactionData data;
+    EXPECT_EQ(data.addTransactions({t}), 1u);
+    const Transaction& stored = data.getAllTransactions()[0];
+    ASSERT_NE(stored.merchant, nullptr);
+    EXPECT_EQ(*stored.merchant, "blue bottle");
+    EXPECT_EQ(&merchantKey(stored), stored.merchant);
+    
+    // The same charge exported without the processor prefix and location
+    t.description = "BLUE BOTTLE #0423";
+    EXPECT_EQ(data.addTransactions({t}), 0u);
+    EXPECT_EQ(data.getDuplicateCount(), 1u);
+}
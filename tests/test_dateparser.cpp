@@ -22,6 +22,19 @@ TEST(DateParserTest, InvalidDateThrows) {
     EXPECT_THROW(DateParser::parse("99/99/9999"), std::invalid_argument);
 }
 
+TEST(DateParserTest, DayNumberRoundTrip) {
+    EXPECT_EQ(DateParser::toDayNumber("1970-01-01"), 0);
+    EXPECT_EQ(DateParser::toDayNumber("2024-03-01") - DateParser::toDayNumber("2024-02-28"), 2);
+    EXPECT_EQ(DateParser::fromDayNumber(DateParser::toDayNumber("2020-12-31")), "2020-12-31");
+    EXPECT_THROW(DateParser::toDayNumber("12/31/2020"), std::invalid_argument);
+    
+    int day = -1;
+    EXPECT_TRUE(DateParser::tryDayNumber("2024-02-28", day));
+    EXPECT_EQ(day, DateParser::toDayNumber("2024-02-28"));
+    EXPECT_FALSE(DateParser::tryDayNumber("2024-13-01", day));
+    EXPECT_FALSE(DateParser::tryDayNumber("", day));
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,87 @@
+// GoogleTest unit tests for the streaming sketches
+#include <gtest/gtest.h>
+#include "HeavyHitters.h"
+#include "HyperLogLog.h"
+#include "QuantileSketch.h"
+
+TEST(QuantileSketchTest, EmptySketch) {
+    QuantileSketch sketch;
+    EXPECT_EQ(sketch.count(), 0u);
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.5), 0.0);
+}
+
+TEST(QuantileSketchTest, ExactForSmallInputs) {
+    QuantileSketch sketch;
+    for (int i = 1; i <= 9; ++i) sketch.add(i);
+    EXPECT_DOUBLE_EQ(sketch.quantile(0.5), 5.0);
+    EXPECT_DOUBLE_EQ(sketch.quantile(1.0), 9.0);
+}
+
+TEST(QuantileSketchTest, BoundedMemoryAndAccuracy) {
+    QuantileSketch sketch(200);
+    const int n = 200000;
+    for (int i = 0; i < n; ++i) {
+        sketch.add((i * 7919) % n);  // Permutation of 0..n-1
+    }
+    EXPECT_EQ(sketch.count(), static_cast<uint64_t>(n));
+    EXPECT_LT(sketch.retainedItems(), 1000u);
+    EXPECT_NEAR(sketch.quantile(0.5), n * 0.5, n * 0.02);
+    EXPECT_NEAR(sketch.quantile(0.9), n * 0.9, n * 0.02);
+    EXPECT_NEAR(sketch.quantile(0.99), n * 0.99, n * 0.02);
+}
+
+TEST(QuantileSketchTest, MergeMatchesSingleStream) {
+    QuantileSketch left, right;
+    for (int i = 0; i < 50000; ++i) left.add(i);
+    for (int i = 50000; i < 100000; ++i) right.add(i);
+    left.merge(right);
+    EXPECT_EQ(left.count(), 100000u);
+    EXPECT_NEAR(left.quantile(0.5), 50000, 2000);
+    EXPECT_NEAR(left.quantile(0.9), 90000, 2000);
+}
+
+TEST(SpaceSavingTest, FindsHeavyHittersWithBoundedCounters) {
+    SpaceSaving sketch(10);
+    for (int i = 0; i < 1000; ++i) {
+        sketch.add("coffee", 5.0);
+        sketch.add("noise" + std::to_string(i), 1.0);
+    }
+    EXPECT_LE(sketch.size(), 10u);
+    auto top = sketch.top(1);
+    ASSERT_EQ(top.size(), 1u);
+    EXPECT_EQ(top[0].key, "coffee");
+    EXPECT_GE(top[0].weight, 5000.0);
+    EXPECT_LE(top[0].weight - top[0].error, 5000.0);
+}
+
+TEST(SpaceSavingTest, MergeCombinesChunks) {
+    SpaceSaving left(4), right(4);
+    left.add("grocer", 100.0);
+    left.add("cafe", 10.0);
+    right.add("grocer", 50.0);
+    right.add("fuel", 70.0);
+    left.merge(right);
+    auto top = left.top(3);
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_EQ(top[0].key, "grocer");
+    EXPECT_DOUBLE_EQ(top[0].weight, 150.0);
+    EXPECT_EQ(top[1].key, "fuel");
+    
+    SpaceSaving copy = left;
+    copy.add("fuel", 100.0);
+    EXPECT_EQ(copy.top(1)[0].key, "fuel");
+    EXPECT_EQ(left.top(1)[0].key, "grocer");
+}
+
+TEST(HyperLogLogTest, EstimatesDistinctCount) {
+    HyperLogLog small;
+    for (int i = 0; i < 3; ++i) small.add("same merchant");
+    EXPECT_NEAR(small.estimate(), 1.0, 0.5);
+    
+    HyperLogLog left, right;
+    for (int i = 0; i < 60000; ++i) left.add("merchant " + std::to_string(i));
+    for (int i = 40000; i < 100000; ++i) right.add("merchant " + std::to_string(i));
+    EXPECT_NEAR(left.estimate(), 60000, 60000 * 0.05);
+    left.merge(right);
+    EXPECT_NEAR(left.estimate(), 100000, 100000 * 0.05);
+}